@@ -13,9 +13,13 @@
 uint8_t camera_type;
 uint8_t camera_device;
 uint8_t camera_mfr = CAMERA_MFR_UNKNOW;
+const camera_driver_t *camera_driver = 0;
 uint8_t camera_profile_eep;
 uint8_t camera_attribute[CAMERA_SETTING_NUM][4];
 uint8_t camera_setting_reg_eep[CAMERA_PROFILE_NUM][CAMERA_SETTING_NUM];
+uint16_t camera_setting_dirty[CAMERA_PROFILE_NUM]; // one bit per setting not yet in eeprom
+uint8_t camera_setting_crc_dirty = 0;              // one bit per profile
+uint8_t camera_setting_flush = 0;
 uint8_t camera_setting_reg_set[CAMERA_SETTING_NUM];
 uint8_t camera_setting_reg_menu[CAMERA_SETTING_NUM];
 uint8_t camera_profile_menu;
@@ -27,15 +31,23 @@ uint8_t reset_isp_need = 0;
 
 uint8_t camera_is_3v3 = 0;
 
+void camera_reg_write_eep(uint16_t addr, uint8_t val) {
+    I2C_Write8_Wait(10, ADDR_EEPROM, addr, val);
+}
+uint8_t camera_reg_read_eep(uint16_t addr) {
+    return I2C_Read8_Wait(10, ADDR_EEPROM, addr);
+}
+
 void camera_type_detect(void) {
     camera_type = CAMERA_TYPE_UNKNOW;
 
-    runcam_type_detect();
+    runcam_type_detect(camera_reg_read_eep(EEP_ADDR_CAM_TYPE));
     if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1 ||
         camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2 ||
         camera_type == CAMERA_TYPE_RUNCAM_NANO_90 ||
         camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3) {
         camera_mfr = CAMERA_MFR_RUNCAM;
+        camera_driver = &runcam_driver;
         return;
     }
 }
@@ -71,8 +83,10 @@ void camera_mode_detect(uint8_t init) {
     uint32_t frame = 0;
     uint32_t agc_en = 0;
     uint8_t id = 0;
+    uint8_t cached;
 
     init = 0;
+    Set_VideoMode_invalidate(); // video path may have been reset
 
 #ifdef USE_TC3587_RSTB
     TC3587_RSTB = 0;
@@ -81,15 +95,27 @@ void camera_mode_detect(uint8_t init) {
     WAIT(100);
 #endif
 
-    Set_720P60_8bit(0);
-    id = I2C_Read8(ADDR_TP9950, 0xfe);
-    id = I2C_Read8(ADDR_TP9950, 0xff);
-    WAIT(200);
+    // A camera that locked last time is verified once instead of probed twice
+    cached = (camera_reg_read_eep(EEP_ADDR_CAM_TYPE) == CAMERA_TYPE_OUTDATED);
 
     Set_720P60_8bit(0);
     id = I2C_Read8(ADDR_TP9950, 0xfe);
     id = I2C_Read8(ADDR_TP9950, 0xff);
-    WAIT(200);
+    if (!cached || I2C_Read8(ADDR_TP9950, 0x01) != 0x7E) {
+        WAIT(200);
+
+        Set_720P60_8bit(0);
+        id = I2C_Read8(ADDR_TP9950, 0xfe);
+        id = I2C_Read8(ADDR_TP9950, 0xff);
+        WAIT(200);
+
+        if (I2C_Read8(ADDR_TP9950, 0x01) == 0x7E) {
+            if (!cached)
+                camera_reg_write_eep(EEP_ADDR_CAM_TYPE, CAMERA_TYPE_OUTDATED);
+        } else if (cached) {
+            camera_reg_write_eep(EEP_ADDR_CAM_TYPE, CAMERA_TYPE_UNKNOW);
+        }
+    }
 
     I2C_Write8(ADDR_TP9950, 0x26, 0x01);
     I2C_Write8(ADDR_TP9950, 0x07, 0xC0);
@@ -165,6 +191,9 @@ void camera_mode_detect(uint8_t init) {
     uint8_t loss = 0;
     uint8_t detect_tries = 0;
     uint8_t status_reg = 0;
+    uint8_t fmt_last;
+
+    Set_VideoMode_invalidate(); // 0x8F reset below, or an isp reset before
 
     // init tc3587 and detect fps
     WriteReg(0, 0x8F, 0x91);
@@ -201,6 +230,11 @@ void camera_mode_detect(uint8_t init) {
         Init_TC3587(0);
         I2C_Write16(ADDR_TC3587, 0x0058, 0x00e0);
     } else {
+        // start from the format that locked last time
+        fmt_last = camera_reg_read_eep(EEP_ADDR_VDO_FMT);
+        if (fmt_last == VDO_FMT_720P50 || fmt_last == VDO_FMT_720P60)
+            video_format = fmt_last;
+
         while (cycles) {
             if (video_format == VDO_FMT_720P50) {
                 Init_TC3587(0);
@@ -221,6 +255,8 @@ void camera_mode_detect(uint8_t init) {
 
             if (loss == 0) {
                 camera_type = CAMERA_TYPE_OUTDATED;
+                if (fmt_last != video_format)
+                    camera_reg_write_eep(EEP_ADDR_VDO_FMT, video_format);
                 break;
             }
 
@@ -257,12 +293,6 @@ void camera_button_init() {
     WriteReg(0, 0x14, 0x00);
 }
 
-void camera_reg_write_eep(uint16_t addr, uint8_t val) {
-    I2C_Write8_Wait(10, ADDR_EEPROM, addr, val);
-}
-uint8_t camera_reg_read_eep(uint16_t addr) {
-    return I2C_Read8_Wait(10, ADDR_EEPROM, addr);
-}
 
 void camera_setting_profile_read(uint8_t profile) {
     uint8_t i, addr;
@@ -271,37 +301,72 @@ void camera_setting_profile_read(uint8_t profile) {
         camera_setting_reg_eep[profile][i] = camera_reg_read_eep(addr);
     }
 }
-void camera_setting_profile_write(uint8_t profile) {
-    uint8_t i, j;
-    uint8_t addr;
-    if (profile == 0xff) {
-        for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-            for (j = 0; j < CAMERA_PROFILE_NUM; j++) {
-                addr = EEP_ADDR_CAM_SETTING + j * CAMERA_SETTING_NUM + i;
-                camera_reg_write_eep(addr, camera_setting_reg_eep[j][i]);
-            }
-        }
-    } else {
-        for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-            addr = EEP_ADDR_CAM_SETTING + profile * CAMERA_SETTING_NUM + i;
-            camera_reg_write_eep(addr, camera_setting_reg_eep[profile][i]);
-        }
-    }
+// 0xff is kept for a profile saved without crc
+uint8_t camera_setting_profile_crc(uint8_t profile) {
+    uint8_t i;
+    uint8_t crc = 0;
+    for (i = 0; i < CAMERA_SETTING_NUM; i++)
+        crc = crc8tab[crc ^ camera_setting_reg_eep[profile][i]];
+    return (crc == 0xff) ? 0 : crc;
+}
+void camera_setting_mark_dirty(uint8_t profile, uint16_t mask) {
+    camera_setting_dirty[profile] |= mask;
+    camera_setting_crc_dirty |= 1 << profile;
+}
+// The dirty settings are written by camera_eep_task()
+void camera_setting_profile_write(void) {
+    camera_setting_flush = 1;
 }
 void camera_setting_profile_reset(uint8_t profile) {
-    if (camera_mfr == CAMERA_MFR_RUNCAM)
-        runcam_setting_profile_reset(camera_setting_reg_eep[profile]);
+    if (camera_driver) {
+        camera_driver->profile_reset(camera_setting_reg_eep[profile]);
+        camera_setting_mark_dirty(profile, 0xffff);
+    }
 }
 void camera_setting_profile_check(uint8_t profile) {
     uint8_t need_reset = 0;
-    if (camera_mfr == CAMERA_MFR_RUNCAM)
-        need_reset = runcam_setting_profile_check(camera_setting_reg_eep[profile]);
+    uint8_t crc = camera_reg_read_eep(EEP_ADDR_CAM_CRC + profile);
+
+    if (crc != 0xff && crc != camera_setting_profile_crc(profile))
+        need_reset = 1;
+    else if (camera_driver)
+        need_reset = camera_driver->profile_check(camera_setting_reg_eep[profile]);
 
     if (need_reset) {
         camera_setting_profile_reset(profile);
-        camera_setting_profile_write(profile);
+        camera_setting_profile_write();
+    } else if (crc == 0xff) {
+        camera_setting_crc_dirty |= 1 << profile;
+        camera_setting_profile_write();
     }
 }
+
+// Write one dirty byte per call, the profile crc goes last
+void camera_eep_task(void) {
+    uint8_t i, j;
+
+    if (!camera_setting_flush)
+        return;
+
+    for (j = 0; j < CAMERA_PROFILE_NUM; j++) {
+        if (camera_setting_dirty[j]) {
+            for (i = 0; i < CAMERA_SETTING_NUM; i++) {
+                if (camera_setting_dirty[j] & ((uint16_t)1 << i)) {
+                    camera_setting_dirty[j] &= ~((uint16_t)1 << i);
+                    camera_reg_write_eep(EEP_ADDR_CAM_SETTING + j * CAMERA_SETTING_NUM + i, camera_setting_reg_eep[j][i]);
+                    return;
+                }
+            }
+        }
+        if (camera_setting_crc_dirty & (1 << j)) {
+            camera_setting_crc_dirty &= ~(1 << j);
+            camera_reg_write_eep(EEP_ADDR_CAM_CRC + j, camera_setting_profile_crc(j));
+            return;
+        }
+    }
+
+    camera_setting_flush = 0;
+}
 void camera_profile_read(void) {
     camera_profile_eep = camera_reg_read_eep(EEP_ADDR_CAM_PROFILE);
 }
@@ -333,8 +398,8 @@ void camera_setting_read(void) {
         camera_profile_write();
         for (i = 0; i < CAMERA_PROFILE_NUM; i++) {
             camera_setting_profile_reset(i);
-            camera_setting_profile_write(i);
         }
+        camera_setting_profile_write();
         camera_reg_write_eep(EEP_ADDR_CAM_TYPE, camera_type);
         i = camera_reg_read_eep(EEP_ADDR_CAM_TYPE);
     } else {
@@ -357,32 +422,44 @@ void camera_setting_reg_menu_update(void) {
 
 void camera_setting_reg_eep_update(void) {
     uint8_t i;
-    for (i = 0; i < CAMERA_SETTING_NUM; i++)
-        camera_setting_reg_eep[camera_profile_menu][i] = camera_setting_reg_menu[i];
+    for (i = 0; i < CAMERA_SETTING_NUM; i++) {
+        if (camera_setting_reg_eep[camera_profile_menu][i] != camera_setting_reg_menu[i]) {
+            camera_setting_reg_eep[camera_profile_menu][i] = camera_setting_reg_menu[i];
+            camera_setting_mark_dirty(camera_profile_menu, (uint16_t)1 << i);
+        }
+    }
 }
 
 uint8_t camera_set(uint8_t *camera_setting_reg, uint8_t save, uint8_t init) {
     uint8_t ret = 0;
-    if (camera_mfr == CAMERA_MFR_RUNCAM) {
-        ret = runcam_set(camera_setting_reg);
+    if (camera_driver) {
+        ret = camera_driver->apply_profile(camera_setting_reg);
         if (save || (init & ret))
-            runcam_save();
+            camera_driver->save();
     }
 
     return ret;
 }
 
+uint8_t camera_apply_setting(uint8_t id, uint8_t val) {
+    if (!camera_driver)
+        return 0;
+    return camera_driver->apply_setting(CAM_SETTING_ID_VAL(id, val));
+}
+
+void camera_reset_isp(void) {
+    if (camera_driver)
+        camera_driver->reset_isp();
+}
+
 void camera_init(void) {
     camera_type_detect();
     camera_setting_read();
     camera_setting_reg_menu_update();
     reset_isp_need = camera_set(camera_setting_reg_menu, 0, 1);
 
-    if (reset_isp_need) {
-        if (camera_mfr == CAMERA_MFR_RUNCAM) {
-            runcam_reset_isp();
-        }
-    }
+    if (reset_isp_need)
+        camera_reset_isp();
 
     camera_mode_detect(1);
 
@@ -417,8 +494,8 @@ void camera_button_op(uint8_t op) {
 void camera_menu_draw_bracket(void) {
     uint8_t i;
     for (i = CAM_STATUS_BRIGHTNESS; i <= CAM_STATUS_VDO_FMT; i++) {
-        osd_buf[i][osd_menu_offset + 18] = '<';
-        osd_buf[i][osd_menu_offset + 29] = '>';
+        menu_char(i, osd_menu_offset + 18, '<');
+        menu_char(i, osd_menu_offset + 29, '>');
     }
 }
 
@@ -430,91 +507,74 @@ void camera_menu_draw_value(void) {
     const char *resolution_runcam_nano_90[] = {"   540P@90", "540@90CROP", "   540P@60", "960X720@60"};
     const char *resolution_runcam_micro_v3[] = {"      4:3 ", " 16:9CROP ", " 16:9FULL ", "  1080@30 "};
 
-    uint8_t str[4];
+    uint8_t str[5];
     uint8_t i;
     uint8_t dat;
 
     // profile
-    osd_buf[0][osd_menu_offset + 28] = '1' + camera_profile_menu;
+    menu_char(0, osd_menu_offset + 28, '1' + camera_profile_menu);
 
     for (i = CAM_STATUS_BRIGHTNESS; i <= CAM_STATUS_VDO_FMT; i++) {
         if (camera_attribute[i - 1][CAM_SETTING_ITEM_ENBALE] == 0)
-            strcpy(&osd_buf[i][osd_menu_offset + 27], "-");
+            menu_value(i, osd_menu_offset + 27, 2, "-");
         else {
             switch (i) {
-            case CAM_STATUS_BRIGHTNESS: // brightness
-                if (camera_setting_reg_menu[0] > camera_attribute[0][CAM_SETTING_ITEM_DEFAULT]) {
+            case CAM_STATUS_BRIGHTNESS: // brightness, signed offset from default
+                if (camera_setting_reg_menu[0] > camera_attribute[0][CAM_SETTING_ITEM_DEFAULT])
                     dat = camera_setting_reg_menu[0] - camera_attribute[0][CAM_SETTING_ITEM_DEFAULT];
-                    uint8ToString(dat, str);
-                    if (dat > 99) {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], "+");
-                        strcpy(&osd_buf[1][osd_menu_offset + 25], str);
-                    } else if (dat > 9) {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], " +");
-                        strcpy(&osd_buf[1][osd_menu_offset + 26], str + 1);
-                    } else {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], "  +");
-                        strcpy(&osd_buf[1][osd_menu_offset + 27], str + 2);
-                    }
-                } else if (camera_setting_reg_menu[0] < camera_attribute[0][CAM_SETTING_ITEM_DEFAULT]) {
+                else
                     dat = camera_attribute[0][CAM_SETTING_ITEM_DEFAULT] - camera_setting_reg_menu[0];
-                    uint8ToString(dat, str);
-                    if (dat > 99) {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], "-  ");
-                        strcpy(&osd_buf[1][osd_menu_offset + 25], str);
-                    } else if (dat > 9) {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], " -");
-                        strcpy(&osd_buf[1][osd_menu_offset + 26], str + 1);
-                    } else {
-                        strcpy(&osd_buf[1][osd_menu_offset + 24], "  -");
-                        strcpy(&osd_buf[1][osd_menu_offset + 27], str + 2);
-                    }
-                } else {
-                    strcpy(&osd_buf[1][osd_menu_offset + 24], "   0");
+                str[0] = ' ';
+                uint8ToString(dat, str + 1);
+                if (dat) {
+                    // sign right before the first digit
+                    str[(dat > 99) ? 0 : (dat > 9) ? 1 : 2] =
+                        (camera_setting_reg_menu[0] > camera_attribute[0][CAM_SETTING_ITEM_DEFAULT]) ? '+' : '-';
                 }
+                menu_value(1, osd_menu_offset + 24, 5, (char *)str);
                 break;
             case CAM_STATUS_SHARPNESS:
             case CAM_STATUS_CONTRAST:
             case CAM_STATUS_SATURATION:
                 uint8ToString(camera_setting_reg_menu[i - 1] + 1, str);
-                strcpy(&osd_buf[i][osd_menu_offset + 25], str);
+                menu_value(i, osd_menu_offset + 25, 4, (char *)str);
                 break;
             case CAM_STATUS_SHUTTER:
                 if (camera_setting_reg_menu[i - 1] == 0)
-                    strcpy(&osd_buf[i][osd_menu_offset + 24], "AUTO");
+                    menu_value(i, osd_menu_offset + 24, 5, "AUTO");
                 else {
-                    uint8ToString(camera_setting_reg_menu[i - 1], str);
-                    osd_buf[i][osd_menu_offset + 24] = ' ';
-                    strcpy(&osd_buf[i][osd_menu_offset + 25], str);
+                    str[0] = ' ';
+                    uint8ToString(camera_setting_reg_menu[i - 1], str + 1);
+                    menu_value(i, osd_menu_offset + 24, 5, (char *)str);
                 }
                 break;
 
             case CAM_STATUS_WBRED:  // wb red
             case CAM_STATUS_WBBLUE: // wb blue
                 uint8ToString(camera_setting_reg_menu[i - 1], str);
-                strcpy(&osd_buf[i][osd_menu_offset + 25], str);
+                menu_value(i, osd_menu_offset + 25, 4, (char *)str);
                 break;
             case CAM_STATUS_HVFLIP: // hv flip
-                strcpy(&osd_buf[i][osd_menu_offset + 21], hv_flip_str[camera_setting_reg_menu[i - 1]]);
+                menu_value(i, osd_menu_offset + 21, 8, hv_flip_str[camera_setting_reg_menu[i - 1]]);
                 break;
             case CAM_STATUS_NIGHT_MODE: // night mode
             case CAM_STATUS_LED_MODE:   // led mode
-                strcpy(&osd_buf[i][osd_menu_offset + 21], switch_str[camera_setting_reg_menu[i - 1]]);
+                menu_value(i, osd_menu_offset + 21, 8, switch_str[camera_setting_reg_menu[i - 1]]);
                 break;
 
             case CAM_STATUS_WBMODE: // wb mode
-                strcpy(&osd_buf[i][osd_menu_offset + 21], wb_mode_str[camera_setting_reg_menu[i - 1]]);
+                menu_value(i, osd_menu_offset + 21, 8, wb_mode_str[camera_setting_reg_menu[i - 1]]);
                 break;
 
             case CAM_STATUS_VDO_FMT: // vdo fmt
                 if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2) {
-                    strcpy(&osd_buf[i][osd_menu_offset + 19], resolution_runcam_micro_v2[camera_setting_reg_menu[i - 1]]);
+                    menu_value(i, osd_menu_offset + 19, 10, resolution_runcam_micro_v2[camera_setting_reg_menu[i - 1]]);
                 } else if (camera_type == CAMERA_TYPE_RUNCAM_NANO_90) {
-                    strcpy(&osd_buf[i][osd_menu_offset + 19], resolution_runcam_nano_90[camera_setting_reg_menu[i - 1]]);
+                    menu_value(i, osd_menu_offset + 19, 10, resolution_runcam_nano_90[camera_setting_reg_menu[i - 1]]);
                 } else if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3) {
-                    strcpy(&osd_buf[i][osd_menu_offset + 19], resolution_runcam_micro_v3[camera_setting_reg_menu[i - 1]]);
+                    menu_value(i, osd_menu_offset + 19, 10, resolution_runcam_micro_v3[camera_setting_reg_menu[i - 1]]);
                 }
-                osd_buf[i][osd_menu_offset + 29] = '>';
+                menu_char(i, osd_menu_offset + 29, '>');
                 break;
             default:
                 break;
@@ -542,16 +602,13 @@ void camera_menu_init(void) {
         "EXIT",
         "SAVE&EXIT",
     };
-    char *osd_buf_p;
     uint8_t i;
 
     memset(osd_buf, 0x20, sizeof(osd_buf));
     disp_mode = DISPLAY_CMS;
 
-    for (i = 0; i <= 15; i++) {
-        osd_buf_p = osd_buf[i] + osd_menu_offset + 3;
-        strcpy(osd_buf_p, cam_menu_string[i]);
-    }
+    for (i = 0; i <= 15; i++)
+        menu_label(i, osd_menu_offset + 3, cam_menu_string[i]);
     camera_profile_menu = camera_profile_eep;
     camera_setting_reg_menu_update();
     camera_menu_draw_bracket();
@@ -577,10 +634,7 @@ void camera_menu_show_saving(void) {
 }
 
 void camera_menu_cursor_update(uint8_t erase) {
-    if (erase)
-        osd_buf[camMenuStatus][osd_menu_offset + 2] = ' ';
-    else
-        osd_buf[camMenuStatus][osd_menu_offset + 2] = '>';
+    menu_char(camMenuStatus, osd_menu_offset + 2, erase ? ' ' : '>');
 }
 void camera_menu_item_toggle(uint8_t op) {
     camera_menu_cursor_update(1);
@@ -657,7 +711,7 @@ void camera_setting_reg_menu_toggle(uint8_t op, uint8_t last_op) {
             if (camera_setting_reg_menu[item] > camera_attribute[item][CAM_SETTING_ITEM_MAX])
                 camera_setting_reg_menu[item] = camera_attribute[item][CAM_SETTING_ITEM_MAX];
 
-            camera_set(camera_setting_reg_menu, 0, 0);
+            camera_apply_setting(item, camera_setting_reg_menu[item]);
         } else if (op == BTN_LEFT) {
             step = camera_menu_long_press(op, last_op, 0);
             if (((camera_setting_reg_menu[item] - step) & 0xff) > camera_setting_reg_menu[item]) // overflow
@@ -668,7 +722,7 @@ void camera_setting_reg_menu_toggle(uint8_t op, uint8_t last_op) {
             if (camera_setting_reg_menu[item] < camera_attribute[item][CAM_SETTING_ITEM_MIN])
                 camera_setting_reg_menu[item] = camera_attribute[item][CAM_SETTING_ITEM_MIN];
 
-            camera_set(camera_setting_reg_menu, 0, 0);
+            camera_apply_setting(item, camera_setting_reg_menu[item]);
         } else if (op == BTN_MID) {
             step = camera_menu_long_press(op, last_op, 1);
         }
@@ -691,7 +745,7 @@ void camera_setting_reg_menu_toggle(uint8_t op, uint8_t last_op) {
                 camera_setting_reg_menu[item] = camera_attribute[item][CAM_SETTING_ITEM_MIN];
 
             if (camMenuStatus != CAM_STATUS_VDO_FMT) { // vdo format will be configured when exit camera menu
-                camera_set(camera_setting_reg_menu, 0, 0);
+                camera_apply_setting(item, camera_setting_reg_menu[item]);
             }
         } else if (op == BTN_LEFT) {
             camera_setting_reg_menu[item]--;
@@ -702,7 +756,7 @@ void camera_setting_reg_menu_toggle(uint8_t op, uint8_t last_op) {
                 camera_setting_reg_menu[item] = camera_attribute[item][CAM_SETTING_ITEM_MAX];
 
             if (camMenuStatus != CAM_STATUS_VDO_FMT) { // vdo format will be configured when exit camera menu
-                camera_set(camera_setting_reg_menu, 0, 0);
+                camera_apply_setting(item, camera_setting_reg_menu[item]);
             }
         }
         break;
@@ -814,17 +868,16 @@ uint8_t camera_status_update(uint8_t op) {
                 camera_profile_write();
                 reset_isp_need |= camera_set(camera_setting_reg_menu, 1, 0);
                 camera_setting_reg_eep_update();
-                camera_setting_profile_write(0xff);
+                camera_setting_profile_write();
 
                 if (reset_isp_need) {
-                    if (camera_mfr == CAMERA_MFR_RUNCAM) {
-                        runcam_reset_isp();
+                    if (camera_driver) {
+                        camera_reset_isp();
                         camera_mode_detect(0);
                     }
                 }
-                camera_menu_show_saving();
-                saving_start_sec = seconds;
-                camMenuStatus = CAM_STATUS_SAVING;
+                camMenuStatus = CAM_STATUS_IDLE;
+                ret = 1;
             }
         }
         break;
@@ -833,10 +886,10 @@ uint8_t camera_status_update(uint8_t op) {
             camera_profile_write();
             reset_isp_need |= camera_set(camera_setting_reg_menu, 1, 0);
             camera_setting_reg_eep_update();
-            camera_setting_profile_write(0xff);
+            camera_setting_profile_write();
             if (reset_isp_need) {
-                if (camera_mfr == CAMERA_MFR_RUNCAM) {
-                    runcam_reset_isp();
+                if (camera_driver) {
+                    camera_reset_isp();
                     camera_mode_detect(0);
                 }
             }
@@ -885,34 +938,25 @@ void camera_select_menu_init(void) {
         "  VTX RATIO FOR LUX CAMERA  <4:3> ",
         "  EXIT",
     };
-    char *osd_buf_p;
     uint8_t i;
 
-    for (i = 0; i <= CAM_SELECT_EXIT; i++) {
-        osd_buf_p = osd_buf[i] + osd_menu_offset;
-        strcpy(osd_buf_p, cam_select_menu_string[i]);
-    }
+    for (i = 0; i <= CAM_SELECT_EXIT; i++)
+        menu_label(i, osd_menu_offset, cam_select_menu_string[i]);
     camera_select_menu_ratio_upate();
 }
 
 void camera_select_menu_cursor_update(uint8_t index) {
-    uint8_t i;
-    for (i = 0; i <= CAM_SELECT_EXIT; i++) {
-        if (i == index)
-            osd_buf[i][osd_menu_offset] = '>';
-        else
-            osd_buf[i][osd_menu_offset] = ' ';
-    }
+    menu_cursor(osd_menu_offset, 0, CAM_SELECT_EXIT, index);
 }
 
 void camera_select_menu_ratio_upate() {
     if (camRatio == 1)
-        strcpy(osd_buf[2] + osd_menu_offset + 28, "<4:3> ");
+        menu_label(2, osd_menu_offset + 28, "<4:3> ");
     else
-        strcpy(osd_buf[2] + osd_menu_offset + 28, "<16:9>");
+        menu_label(2, osd_menu_offset + 28, "<16:9>");
 }
 
 void camera_menu_mode_exit_note() {
     const char note_string[] = "LEFT MOVE THROTTLE TO EXIT CAMERA MENU";
-    strcpy(osd_buf[15] + 5, note_string);
+    menu_label(15, 5, note_string);
 }
\ No newline at end of file
@@ -59,6 +59,34 @@ typedef enum {
     CAM_SETTING_ITEM_DEFAULT,
 } camera_setting_attribute_e;
 
+typedef enum {
+    CAM_SETTING_BRIGHTNESS,
+    CAM_SETTING_SHARPNESS,
+    CAM_SETTING_CONTRAST,
+    CAM_SETTING_SATURATION,
+    CAM_SETTING_SHUTTER,
+    CAM_SETTING_WBMODE,
+    CAM_SETTING_WBRED,
+    CAM_SETTING_WBBLUE,
+    CAM_SETTING_HVFLIP,
+    CAM_SETTING_NIGHT_MODE,
+    CAM_SETTING_LED_MODE,
+    CAM_SETTING_VDO_FMT,
+} camera_setting_e;
+
+// apply_setting() takes the id and value packed into one argument, SDCC can
+// only call non-reentrant functions with a single argument through a pointer.
+#define CAM_SETTING_ID_VAL(id, val) (((uint16_t)(id) << 8) | (val))
+
+typedef struct {
+    void (*profile_reset)(uint8_t *setting_profile);
+    uint8_t (*profile_check)(uint8_t *setting_profile);
+    uint8_t (*apply_setting)(uint16_t id_val);
+    uint8_t (*apply_profile)(uint8_t *setting_profile); // returns 1 if isp reset is needed
+    void (*save)(void);
+    void (*reset_isp)(void);
+} camera_driver_t;
+
 typedef enum {
     CAM_STATUS_IDLE = 0xff,
     CAM_STATUS_PROFILE = 0x00,
@@ -98,6 +126,7 @@ void camera_select_menu_init(void);
 void camera_select_menu_cursor_update(uint8_t index);
 void camera_select_menu_ratio_upate();
 void camera_menu_mode_exit_note();
+void camera_eep_task(void);
 
 extern uint8_t camRatio;
 extern uint8_t video_format;
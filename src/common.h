@@ -96,6 +96,9 @@
 #endif
 
 #define INIT_VTX_TABLE
+// #define USE_OSD_BACK_BUFFER // stage FC writes, commit on SUBCMD_DRAW (+1.5KB xdata)
+#define USE_TELEMETRY // 1Hz thermal/RF ring, read by MSP_VTX_GET_TELEMETRY (+112B xdata)
+// #define USE_TELEMETRY_VRX // also stream each sample to the VRX, needs VRX support
 #define IS_RX 0
 
 // time
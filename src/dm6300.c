@@ -16,6 +16,9 @@ typedef struct {
 } dm6300_reg_value_t;
 
 int16_t auxadc_offset = 0;
+int16_t auxadc_temp_min = 0x7FFF;
+int16_t auxadc_temp_max = -0x7FFF;
+static uint8_t auxadc_pending = 0;
 uint32_t init6300_fcnt = 0;
 uint32_t init6300_fnum[FREQ_NUM_EXTERNAL] = {0};
 
@@ -387,44 +390,35 @@ void DM6300_RFTest() {
         SPI_Write(0x6, 0xFF0, 0x00000018);
 }
 
-void DM6300_InitAUXADC() {
+// Select an AUXADC input and read one conversion
+static int16_t DM6300_SampleAUXADC(uint32_t mux) {
     uint32_t dat;
-    int16_t dat1, dat2, dat3;
-
-    SPI_Write(0x6, 0xFF0, 0x00000018);
-    SPI_Read(0x3, 0x254, &dat);
-    dat |= 0x200;
-    SPI_Write(0x3, 0x254, dat);
-
-    SPI_Write(0x6, 0xFF0, 0x00000019);
-    SPI_Write(0x3, 0x17C, 0x19);
 
     SPI_Write(0x6, 0xFF0, 0x00000018);
-    SPI_Write(0x3, 0x2A0, 0xC05B55FE);
+    SPI_Write(0x3, 0x2A0, mux);
     SPI_Write(0x6, 0xFF0, 0x00000019);
 #ifndef HDZERO_RACE_V2
     WAIT(1);
 #endif
     SPI_Read(0x3, 0x17C, &dat);
-    dat1 = ((int32_t)dat) >> 20;
+    return ((int32_t)dat) >> 20;
+}
 
-    SPI_Write(0x6, 0xFF0, 0x00000018);
-    SPI_Write(0x3, 0x2A0, 0x305B55FE);
-    SPI_Write(0x6, 0xFF0, 0x00000019);
-#ifndef HDZERO_RACE_V2
-    WAIT(1);
-#endif
-    SPI_Read(0x3, 0x17C, &dat);
-    dat2 = ((int32_t)dat) >> 20;
+void DM6300_InitAUXADC() {
+    uint32_t dat;
+    int16_t dat1, dat2, dat3;
 
     SPI_Write(0x6, 0xFF0, 0x00000018);
-    SPI_Write(0x3, 0x2A0, 0xA05B51FE);
+    SPI_Read(0x3, 0x254, &dat);
+    dat |= 0x200;
+    SPI_Write(0x3, 0x254, dat);
+
     SPI_Write(0x6, 0xFF0, 0x00000019);
-#ifndef HDZERO_RACE_V2
-    WAIT(1);
-#endif
-    SPI_Read(0x3, 0x17C, &dat);
-    dat3 = ((int32_t)dat) >> 20;
+    SPI_Write(0x3, 0x17C, 0x19);
+
+    dat1 = DM6300_SampleAUXADC(0xC05B55FE);
+    dat2 = DM6300_SampleAUXADC(0x305B55FE);
+    dat3 = DM6300_SampleAUXADC(0xA05B51FE);
 
     auxadc_offset = dat3 - ((dat1 + dat2) >> 1);
 #ifndef HDZERO_RACE_V2
@@ -437,6 +431,7 @@ void DM6300_AUXADC_Calib() {
     WriteReg(0, 0x8F, 0x01);
     DM6300_InitAUXADC();
     WriteReg(0, 0x8F, 0x11);
+    auxadc_pending = 0; // started against the old offset
     dm6300_init_done = 1;
 }
 /*void DM6300_CalibRF()
@@ -464,24 +459,42 @@ void DM6300_AUXADC_Calib() {
     DM6300_SetSingleTone(0);
 }*/
 
-int16_t DM6300_GetTemp() {
+// Split-phase temperature read. DM6300_StartTemp() selects the AUXADC
+// page and returns; DM6300_ReadTemp() collects the conversion on a later
+// scheduler tick, which replaces the WAIT(1) in between.
+// Select the temperature input, the conversion runs until DM6300_ReadTemp().
+// The mux is written every time, DM6300_AUXADC_Calib() leaves it on the
+// calibration input.
+void DM6300_StartTemp() {
     static uint8_t init = 1;
-    uint32_t dat;
-    int16_t temp;
 
+    SPI_Write(0x6, 0xFF0, 0x00000018);
     if (init) {
         init = 0;
-        SPI_Write(0x6, 0xFF0, 0x00000018);
         SPI_Write(0x3, 0x2C0, 0x00000100);
-        SPI_Write(0x3, 0x2A0, 0xA04005FE);
     }
+    SPI_Write(0x3, 0x2A0, 0xA04005FE);
 
     SPI_Write(0x6, 0xFF0, 0x00000019);
-    WAIT(1);
+    auxadc_pending = 1;
+}
+
+uint8_t DM6300_ReadTemp(int16_t *temp) {
+    uint32_t dat;
+
+    if (!auxadc_pending)
+        return 0;
+    auxadc_pending = 0;
+
+    SPI_Write(0x6, 0xFF0, 0x00000019); // page may have moved since the start
     SPI_Read(0x3, 0x17C, &dat);
-    temp = (((int32_t)dat) >> 20) + auxadc_offset;
+    *temp = (((int32_t)dat) >> 20) + auxadc_offset;
 
-    return temp;
+    if (*temp < auxadc_temp_min)
+        auxadc_temp_min = *temp;
+    if (*temp > auxadc_temp_max)
+        auxadc_temp_max = *temp;
+    return 1;
 }
 
 CODE_SEG const dm6300_reg_value_t dm6300_init1_regs[] = {
@@ -18,7 +18,8 @@ void DM6300_SetChannel(uint8_t ch);
 uint8_t DM6300_GetChannelByFreq(uint16_t const freq);
 uint16_t DM6300_GetFreqByChannel(uint8_t const ch);
 void DM6300_SetPower(uint8_t pwr, uint8_t freq, uint8_t offset);
-int16_t DM6300_GetTemp();
+void DM6300_StartTemp();
+uint8_t DM6300_ReadTemp(int16_t *temp);
 void DM6300_AUXADC_Calib();
 
 void DM6300_init1();
@@ -32,6 +33,8 @@ void DM6300_RFTest();
 // void DM6300_M0();
 
 extern int16_t auxadc_offset;
+extern int16_t auxadc_temp_min;
+extern int16_t auxadc_temp_max;
 extern uint8_t table_power[FREQ_NUM_EXTERNAL][POWER_MAX + 1];
 
 extern uint32_t dcoc_ih, dcoc_qh;
@@ -54,8 +54,13 @@ uint8_t cfg_step = 0; // 0:idle, 1:freq, 2:power, 3:LP_MODE
 
 uint8_t cfg_to_cnt = 0;
 uint8_t pwr_lmt_done = 0;
-uint8_t pwr_lmt_sec = 0;
+uint8_t pwr_ramp_idx = 0;
+#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
+// 1W soft-start, DAC codes below table_power[][3]
+CODE_SEG const uint8_t pwr_ramp_curve[] = {0x1C, 0x14, 0x0E, 0x09, 0x05, 0x02, 0x00};
+#endif
 int16_t temperature = 0;
+uint8_t temp_ready = 0; // temperature holds a real sample
 uint8_t pwr_offset = 0;
 uint8_t heat_protect = 0;
 
@@ -114,7 +119,6 @@ const uint8_t diag_led_flags_pit[64] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
 uint8_t temp_err = 0;
 #ifdef USE_TEMPERATURE_SENSOR
 int16_t temp0 = 0;
-uint8_t p;
 #endif
 
 uint8_t i = 0;
@@ -154,192 +158,46 @@ uint8_t check_uart_loopback();
 #endif
 void reset_config();
 
-void Set_720P50(uint8_t page) {
-    WriteReg(page, 0x21, 0x25);
-
-    WriteReg(page, 0x40, 0x00);
-    WriteReg(page, 0x41, 0x25);
-    WriteReg(page, 0x42, 0xD0);
-    WriteReg(page, 0x43, 0xBC);
-    WriteReg(page, 0x44, 0x47);
-    WriteReg(page, 0x45, 0xEE);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x19);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x00);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_720P60(uint8_t page) {
-    WriteReg(page, 0x21, 0x1F);
-
-    WriteReg(page, 0x40, 0x00);
-    WriteReg(page, 0x41, 0x25);
-    WriteReg(page, 0x42, 0xD0);
-    WriteReg(page, 0x43, 0x72);
-    WriteReg(page, 0x44, 0x46);
-    WriteReg(page, 0x45, 0xEE);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x19);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x00);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_720P60_8bit(uint8_t page) {
-    WriteReg(page, 0x21, 0x1F);
-
-    WriteReg(page, 0x40, 0x00);
-    WriteReg(page, 0x41, 0x2A);
-    WriteReg(page, 0x42, 0xD0);
-    WriteReg(page, 0x43, 0xE4);
-    WriteReg(page, 0x44, 0x4C);
-    WriteReg(page, 0x45, 0xEE);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x19);
-    WriteReg(page, 0x4f, 0x86);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x00);
-    WriteReg(page, 0x54, 0x3C);
-    WriteReg(0, 0x8e, 0x04);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_960x720P60(uint8_t page) {
-    WriteReg(page, 0x21, 0x1C);
-
-    WriteReg(page, 0x40, 0xC0);
-    WriteReg(page, 0x41, 0x23);
-    WriteReg(page, 0x42, 0xD0);
-    WriteReg(page, 0x43, 0x49);
-    WriteReg(page, 0x44, 0x45);
-    WriteReg(page, 0x45, 0xE3);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x08);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x02);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_720P30(uint8_t page, uint8_t is_43) {
-    if (is_43)
-        WriteReg(page, 0x21, 0x28);
-    else
-        WriteReg(page, 0x21, 0x1F);
-
-    WriteReg(page, 0x40, 0x00);
-    WriteReg(page, 0x41, 0x25);
-    WriteReg(page, 0x42, 0xB0);
-    WriteReg(page, 0x43, 0xD4);
-    WriteReg(page, 0x44, 0x88);
-    WriteReg(page, 0x45, 0x47);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x19);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x00);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_540P90(uint8_t page) {
-    WriteReg(page, 0x21, 0x21);
-
-    WriteReg(page, 0x40, 0xD0);
-    WriteReg(page, 0x41, 0x22);
-    WriteReg(page, 0x42, 0x18);
-
-    // WriteReg(page, 0x43, 0xD4); //pat
-    // WriteReg(page, 0x44, 0x45);
-
-    WriteReg(page, 0x43, 0x1F); // cam
-    WriteReg(page, 0x44, 0x44);
-
-    WriteReg(page, 0x45, 0x29);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x08);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x02);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
-
-void Set_540P90_crop(uint8_t page) {
-    WriteReg(page, 0x21, 0x1f);
-
-    WriteReg(page, 0x40, 0xD0);
-    WriteReg(page, 0x41, 0x22);
-    WriteReg(page, 0x42, 0x18);
-
-    // WriteReg(page, 0x43, 0xD4); //pat
-    // WriteReg(page, 0x44, 0x45);
-
-    WriteReg(page, 0x43, 0x1F); // cam
-    WriteReg(page, 0x44, 0x44);
+// Video format registers, one row per vdo_mode_e, applied by Set_VideoMode()
+CODE_SEG const uint8_t vdo_reg_addr[VDO_REG_NUM] = {
+    0x21, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x49, 0x4c, 0x4f, 0x52, 0x53, 0x54};
+
+CODE_SEG const uint8_t vdo_reg_tab[VDO_MODE_NUM][VDO_REG_NUM] = {
+    {0x25, 0x00, 0x25, 0xD0, 0xBC, 0x47, 0xEE, 0x04, 0x19, 0x00, 0x04, 0x00, 0x3C}, // 720P50
+    {0x1F, 0x00, 0x25, 0xD0, 0x72, 0x46, 0xEE, 0x04, 0x19, 0x00, 0x04, 0x00, 0x3C}, // 720P60
+    {0x1F, 0x00, 0x2A, 0xD0, 0xE4, 0x4C, 0xEE, 0x04, 0x19, 0x86, 0x04, 0x00, 0x3C}, // 720P60 8bit
+    {0x1C, 0xC0, 0x23, 0xD0, 0x49, 0x45, 0xE3, 0x04, 0x08, 0x00, 0x04, 0x02, 0x3C}, // 960x720P60
+    {0x1F, 0x00, 0x25, 0xB0, 0xD4, 0x88, 0x47, 0x04, 0x19, 0x00, 0x04, 0x00, 0x3C}, // 720P30
+    {0x28, 0x00, 0x25, 0xB0, 0xD4, 0x88, 0x47, 0x04, 0x19, 0x00, 0x04, 0x00, 0x3C}, // 720P30 4:3
+    {0x21, 0xD0, 0x22, 0x18, 0x1F, 0x44, 0x29, 0x04, 0x08, 0x00, 0x04, 0x02, 0x3C}, // 540P90, pat: 0x43=0xD4 0x44=0x45
+    {0x1F, 0xD0, 0x22, 0x18, 0x1F, 0x44, 0x29, 0x04, 0x08, 0x00, 0x04, 0x02, 0x3C}, // 540P90 crop
+    {0x1F, 0xD0, 0x22, 0x18, 0x50, 0x46, 0x6B, 0x04, 0x08, 0x00, 0x04, 0x02, 0x3C}, // 540P60, pat: 0x43=0xD0 0x44=0x47
+    {0x1B, 0x80, 0x47, 0x38, 0x98, 0x88, 0x65, 0x04, 0x29, 0x00, 0x04, 0x00, 0x5A}, // 1080P30
+};
 
-    WriteReg(page, 0x45, 0x29);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x08);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x02);
-    WriteReg(page, 0x54, 0x3C);
+uint8_t vdo_mode_cur = VDO_MODE_NUM; // page 0 mode programmed last, VDO_MODE_NUM: unknown
 
-    WriteReg(page, 0x06, 0x01);
+// Force the next Set_VideoMode() to write every register, after the video
+// path was reset or the camera re-detected
+void Set_VideoMode_invalidate(void) {
+    vdo_mode_cur = VDO_MODE_NUM;
 }
 
-void Set_540P60(uint8_t page) {
-    WriteReg(page, 0x21, 0x1F);
+// Only the registers that differ from the mode programmed last are written
+void Set_VideoMode(uint8_t page, uint8_t mode) {
+    uint8_t cur = vdo_mode_cur;
+    uint8_t i, v;
 
-    WriteReg(page, 0x40, 0xD0);
-    WriteReg(page, 0x41, 0x22);
-    WriteReg(page, 0x42, 0x18);
-
-    // WriteReg(page, 0x43, 0xD0); //pat
-    // WriteReg(page, 0x44, 0x47);
-
-    WriteReg(page, 0x43, 0x50); // cam
-    WriteReg(page, 0x44, 0x46);
-
-    WriteReg(page, 0x45, 0x6B);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x08);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x02);
-    WriteReg(page, 0x54, 0x3C);
-
-    WriteReg(page, 0x06, 0x01);
-}
+    for (i = 0; i < VDO_REG_NUM; i++) {
+        v = vdo_reg_tab[mode][i];
+        if (page || cur >= VDO_MODE_NUM || vdo_reg_tab[cur][i] != v)
+            WriteReg(page, vdo_reg_addr[i], v);
+    }
+    if (page == 0)
+        vdo_mode_cur = mode;
 
-void Set_1080P30(uint8_t page) {
-    WriteReg(page, 0x21, 0x1B);
-
-    WriteReg(page, 0x40, 0x80);
-    WriteReg(page, 0x41, 0x47);
-    WriteReg(page, 0x42, 0x38);
-    WriteReg(page, 0x43, 0x98);
-    WriteReg(page, 0x44, 0x88);
-    WriteReg(page, 0x45, 0x65);
-    WriteReg(page, 0x49, 0x04);
-    WriteReg(page, 0x4c, 0x29);
-    WriteReg(page, 0x4f, 0x00);
-    WriteReg(page, 0x52, 0x04);
-    WriteReg(page, 0x53, 0x00);
-    WriteReg(page, 0x54, 0x5A);
+    if (mode == VDO_MODE_720P60_8BIT)
+        WriteReg(0, 0x8e, 0x04);
 
     WriteReg(page, 0x06, 0x01);
 }
@@ -532,43 +390,112 @@ void Init_HW() {
     // WriteReg(0, 0x25, 0xf6);
     // WriteReg(0, 0x26, 0x00);
 }
+// Per-target thermal description, temperatures in (temperature >> 2) units.
+// Everything below is generated from these values at compile time.
+#ifdef USE_TEMPERATURE_SENSOR
+#if defined HDZERO_FREESTYLE_V2
+#define THERMAL_TEMP_MAX  95
+#define THERMAL_SOFT_MAX  88
+#define THERMAL_OFS_SHIFT 0
+#define THERMAL_OFS_MAX   16
+#elif defined HDZERO_WHOOP_LITE
+#define THERMAL_OFS_SHIFT 1
+#elif defined HDZERO_ECO
+#define THERMAL_TEMP_BIAS 10
+#elif defined HDZERO_AIO5
+#define THERMAL_TEMP_BIAS 15
+#endif
+#define THERMAL_STEPS 20
+#define THERMAL_LEAD  8
+#define THERMAL_KP    0
+#define THERMAL_KI    3
+#define THERMAL_HYST  2
+#else
+#define THERMAL_STEPS    19
+#define THERMAL_TEMP_MAX 0x5C0
+#define THERMAL_SOFT_MAX 0x598
+#define THERMAL_LEAD     8
+#define THERMAL_KP       3
+#define THERMAL_KI       6
+#define THERMAL_HYST     0x0B
+#endif
+
+#ifndef THERMAL_TEMP_MAX
+#define THERMAL_TEMP_MAX 90
+#endif
+#ifndef THERMAL_SOFT_MAX
+#define THERMAL_SOFT_MAX 83
+#endif
+#ifndef THERMAL_OFS_SHIFT
+#define THERMAL_OFS_SHIFT 0
+#endif
+#ifndef THERMAL_OFS_MAX
+#define THERMAL_OFS_MAX THERMAL_STEPS
+#endif
+#ifndef THERMAL_TEMP_BIAS
+#define THERMAL_TEMP_BIAS 0
+#endif
+
+CODE_SEG const thermal_cal_t thermal_cal = {THERMAL_SOFT_MAX, THERMAL_LEAD, THERMAL_KP, THERMAL_KI, THERMAL_HYST};
+
+// Compensation step thresholds, step n starts at entry n-1
+#ifdef USE_TEMPERATURE_SENSOR
+CODE_SEG const int16_t thermal_thr[THERMAL_STEPS] = {
+    25, 30, 35, 38, 40, 43, 45, 48, 50, 53,
+    55, 58, 60, 63, 65, 68, 70, 73, 75, 78};
+#else
+CODE_SEG const int16_t thermal_thr[2][THERMAL_STEPS] = {
+    // RF_POWER == 0
+    {0x479, 0x488, 0x4A2, 0x4B5, 0x4C7, 0x4DD, 0x4F0, 0x500, 0x512, 0x524,
+     0x534, 0x544, 0x554, 0x564, 0x574, 0x582, 0x592, 0x59D, 0x5AC},
+    // RF_POWER > 0
+    {0x479, 0x488, 0x4A2, 0x4B5, 0x4C7, 0x4DD, 0x4F0, 0x500, 0x512, 0x523,
+     0x533, 0x543, 0x552, 0x562, 0x572, 0x580, 0x590, 0x59B, 0x5AA},
+};
+#endif
+
+// Step to pwr_offset
+#define THERMAL_OFS(n) ((((n) >> THERMAL_OFS_SHIFT) > THERMAL_OFS_MAX) ? THERMAL_OFS_MAX : ((n) >> THERMAL_OFS_SHIFT))
+CODE_SEG const uint8_t thermal_ofs_tab[21] = {
+    THERMAL_OFS(0), THERMAL_OFS(1), THERMAL_OFS(2), THERMAL_OFS(3), THERMAL_OFS(4),
+    THERMAL_OFS(5), THERMAL_OFS(6), THERMAL_OFS(7), THERMAL_OFS(8), THERMAL_OFS(9),
+    THERMAL_OFS(10), THERMAL_OFS(11), THERMAL_OFS(12), THERMAL_OFS(13), THERMAL_OFS(14),
+    THERMAL_OFS(15), THERMAL_OFS(16), THERMAL_OFS(17), THERMAL_OFS(18), THERMAL_OFS(19),
+    THERMAL_OFS(20)};
+
 #ifdef USE_TEMPERATURE_SENSOR
 void TempDetect() {
     static uint8_t init = 1;
+    static uint8_t init0 = 1;
     int16_t temp_new, temp_new0;
 
     if (timer_2hz) {
-        if (init) {
-            init = 0;
-            temp0 = DM6300_GetTemp();
-            temp0 <<= 2;
-
-            temperature = I2C_Read8(ADDR_TEMPADC, 0); // NCT75 MSB 8bit
-            // temperature >>= 5; //LM75AD
-
-            if (temperature >= 0x7D) // MAX +125
-                temperature = 0x7D;
-            temperature <<= 2; // filter * 4
-        } else {
-            temp_new0 = DM6300_GetTemp();
+        // AUXADC conversion started on the previous 2Hz tick
+        if (DM6300_ReadTemp(&temp_new0)) {
+            if (init0) {
+                init0 = 0;
+                temp0 = temp_new0 << 2;
+            } else
+                temp0 = temp0 - (temp0 >> 2) + temp_new0;
+        }
+        DM6300_StartTemp();
 
-            temp_new = I2C_Read8(ADDR_TEMPADC, 0);
-            if (temp_new >= 0x7D) // MAX +125
-                temp_new = 0x7D;
-                // temp_new >>= 5; //LM75AD
+        temp_new = I2C_Read8(ADDR_TEMPADC, 0); // NCT75 MSB 8bit
+        // temp_new >>= 5; //LM75AD
+        if (temp_new >= 0x7D) // MAX +125
+            temp_new = 0x7D;
 
-#ifdef HDZERO_ECO
-            if (temp_new > 10)
-                temp_new -= 10;
-#elif defined HDZERO_AIO5
-            if (temp_new > 15)
-                temp_new -= 15;
+#if THERMAL_TEMP_BIAS
+        if (temp_new > THERMAL_TEMP_BIAS)
+            temp_new -= THERMAL_TEMP_BIAS;
 #endif
 
+        if (init) {
+            init = 0;
+            temperature = temp_new << 2; // filter * 4
+            temp_ready = 1;
+        } else
             temperature = temperature - (temperature >> 2) + temp_new;
-
-            temp0 = temp0 - (temp0 >> 2) + temp_new0;
-        }
     }
 }
 #else
@@ -580,70 +507,101 @@ void TempDetect() {
         return;
 
     if (timer_2hz) {
-        if (init) {
-            init = 0;
-            temperature = DM6300_GetTemp();
-            temperature <<= 2;
-        } else {
-            temp_new = DM6300_GetTemp();
-            temperature = temperature - (temperature >> 2) + temp_new;
+        // AUXADC conversion started on the previous 2Hz tick
+        if (DM6300_ReadTemp(&temp_new)) {
+            if (init) {
+                init = 0;
+                temperature = temp_new << 2;
+                temp_ready = 1;
+            } else
+                temperature = temperature - (temperature >> 2) + temp_new;
         }
+        DM6300_StartTemp();
     }
 }
 #endif
 
+// Number of thresholds at or below temp, by binary search
+static uint8_t thermal_step(int16_t temp) {
+#ifdef USE_TEMPERATURE_SENSOR
+    const int16_t CODE_SEG *thr = thermal_thr;
+#else
+    const int16_t CODE_SEG *thr = thermal_thr[RF_POWER ? 1 : 0];
+#endif
+    uint8_t lo = 0, hi = THERMAL_STEPS, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (temp < thr[mid])
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
+}
+
 #ifdef USE_TEMPERATURE_SENSOR
 uint8_t temperature_level(void) {
-    int16_t ret;
-    ret = temperature >> 2;
+    return thermal_step(temperature >> 2);
+}
+#endif
 
-    if (ret < 25)
-        ret = 0;
-    else if (ret < 30)
-        ret = 1;
-    else if (ret < 35)
-        ret = 2;
-    else if (ret < 38)
-        ret = 3;
-    else if (ret < 40)
-        ret = 4;
-    else if (ret < 43)
-        ret = 5;
-    else if (ret < 45)
-        ret = 6;
-    else if (ret < 48)
-        ret = 7;
-    else if (ret < 50)
-        ret = 8;
-    else if (ret < 53)
-        ret = 9;
-    else if (ret < 55)
-        ret = 10;
-    else if (ret < 58)
-        ret = 11;
-    else if (ret < 60)
-        ret = 12;
-    else if (ret < 63)
-        ret = 13;
-    else if (ret < 65)
-        ret = 14;
-    else if (ret < 68)
-        ret = 15;
-    else if (ret < 70)
-        ret = 16;
-    else if (ret < 73)
-        ret = 17;
-    else if (ret < 75)
-        ret = 18;
-    else if (ret < 78)
-        ret = 19;
-    else if (ret < 80)
-        ret = 20;
-    else
-        ret = 20;
+// 1Hz thermal power controller. The offset follows the compensation steps at
+// the temperature predicted thermal_cal.lead seconds ahead, only steps down
+// once the temperature is thermal_cal.hyst below the step, and is derated by
+// a PI term above thermal_cal.soft_max so the PA settles under the heat
+// protect limit instead of tripping it.
+static uint8_t thermal_offset(void) {
+    static uint8_t init = 1;
+    static int16_t last_temp;
+    static int16_t rate = 0; // 16x temperature rise per second
+    static int16_t integ = 0;
+    static uint8_t ofs = 0;
+    int16_t temp, pred, err, derate;
+    uint8_t step;
+
+    if (init) {
+        init = 0;
+        last_temp = temperature;
+    }
+    rate += (temperature - last_temp) - (rate >> 2);
+    last_temp = temperature;
+    if (rate > THERMAL_RATE_MAX)
+        rate = THERMAL_RATE_MAX;
+    else if (rate < -THERMAL_RATE_MAX)
+        rate = -THERMAL_RATE_MAX;
+
+    temp = temperature >> 2;
+    pred = temp;
+    if (rate > 0)
+        pred += ((rate >> 2) * thermal_cal.lead) >> 2;
+
+    step = thermal_step(pred);
+    if (step > ofs)
+        ofs = step;
+    else {
+        step = thermal_step(temp + thermal_cal.hyst);
+        if (step < ofs)
+            ofs = step;
+    }
 
-    return (uint8_t)ret;
+    err = pred - thermal_cal.soft_max;
+    integ += err;
+    if (integ < 0)
+        integ = 0;
+    else if (integ > THERMAL_INTEG_MAX)
+        integ = THERMAL_INTEG_MAX;
+
+    derate = integ >> thermal_cal.ki_shift;
+    if (err > 0)
+        derate += err >> thermal_cal.kp_shift;
+
+    if (derate >= ofs)
+        return thermal_ofs_tab[0];
+    return thermal_ofs_tab[ofs - (uint8_t)derate];
 }
+
+#ifdef USE_TEMPERATURE_SENSOR
 void PowerAutoSwitch() {
     static uint8_t last_ofs = 0;
 
@@ -652,15 +610,11 @@ void PowerAutoSwitch() {
     else
         return;
 
-    last_ofs = pwr_offset;
-    pwr_offset = temperature_level();
+    if (!temp_ready) // thermal_offset() seeds its rate from the first sample
+        return;
 
-#ifdef HDZERO_WHOOP_LITE
-    pwr_offset >>= 1;
-#elif defined HDZERO_FREESTYLE_V2
-    if (pwr_offset > 16)
-        pwr_offset = 16;
-#endif
+    last_ofs = pwr_offset;
+    pwr_offset = thermal_offset();
 
     if ((!g_IS_ARMED) && (last_ofs == pwr_offset))
         ;
@@ -671,7 +625,6 @@ void PowerAutoSwitch() {
 }
 #else
 void PowerAutoSwitch() {
-    int16_t temp;
     static uint8_t last_ofs = 0;
 
     if (pwr_sflg)
@@ -679,91 +632,10 @@ void PowerAutoSwitch() {
     else
         return;
 
-    temp = temperature >> 2;
+    if (!temp_ready) // thermal_offset() seeds its rate from the first sample
+        return;
 
-    if (RF_POWER == 0) {
-        if (temp < 0x479)
-            pwr_offset = 0;
-        else if (temp < 0x488)
-            pwr_offset = 1;
-        else if (temp < 0x4A2)
-            pwr_offset = 2;
-        else if (temp < 0x4B5)
-            pwr_offset = 3;
-        else if (temp < 0x4C7)
-            pwr_offset = 4;
-        else if (temp < 0x4DD)
-            pwr_offset = 5;
-        else if (temp < 0x4F0)
-            pwr_offset = 6;
-        else if (temp < 0x500)
-            pwr_offset = 7;
-        else if (temp < 0x512)
-            pwr_offset = 8;
-        else if (temp < 0x524)
-            pwr_offset = 9;
-        else if (temp < 0x534)
-            pwr_offset = 10;
-        else if (temp < 0x544)
-            pwr_offset = 11;
-        else if (temp < 0x554)
-            pwr_offset = 12;
-        else if (temp < 0x564)
-            pwr_offset = 13;
-        else if (temp < 0x574)
-            pwr_offset = 14;
-        else if (temp < 0x582)
-            pwr_offset = 15;
-        else if (temp < 0x592)
-            pwr_offset = 16;
-        else if (temp < 0x59D)
-            pwr_offset = 17;
-        else if (temp < 0x5AC)
-            pwr_offset = 18;
-        else
-            pwr_offset = 19;
-    } else {
-        if (temp < 0x479)
-            pwr_offset = 0;
-        else if (temp < 0x488)
-            pwr_offset = 1;
-        else if (temp < 0x4A2)
-            pwr_offset = 2;
-        else if (temp < 0x4B5)
-            pwr_offset = 3;
-        else if (temp < 0x4C7)
-            pwr_offset = 4;
-        else if (temp < 0x4DD)
-            pwr_offset = 5;
-        else if (temp < 0x4F0)
-            pwr_offset = 6;
-        else if (temp < 0x500)
-            pwr_offset = 7;
-        else if (temp < 0x512)
-            pwr_offset = 8;
-        else if (temp < 0x523)
-            pwr_offset = 9;
-        else if (temp < 0x533)
-            pwr_offset = 10;
-        else if (temp < 0x543)
-            pwr_offset = 11;
-        else if (temp < 0x552)
-            pwr_offset = 12;
-        else if (temp < 0x562)
-            pwr_offset = 13;
-        else if (temp < 0x572)
-            pwr_offset = 14;
-        else if (temp < 0x580)
-            pwr_offset = 15;
-        else if (temp < 0x590)
-            pwr_offset = 16;
-        else if (temp < 0x59B)
-            pwr_offset = 17;
-        else if (temp < 0x5AA)
-            pwr_offset = 18;
-        else
-            pwr_offset = 19;
-    }
+    pwr_offset = thermal_offset();
 
     if (temp_err)
         pwr_offset = 10;
@@ -790,14 +662,8 @@ void HeatProtect() {
     static uint8_t cnt = 0;
     int16_t temp;
 
-#ifdef USE_TEMPERATURE_SENSOR
-#ifdef HDZERO_FREESTYLE_V2
-    int16_t temp_max = 95;
-#else
-    int16_t temp_max = 90;
-#endif
-#else
-    int16_t temp_max = 0x5C0;
+    int16_t temp_max = THERMAL_TEMP_MAX;
+#ifndef USE_TEMPERATURE_SENSOR
     int16_t temp_err_data = 0x700;
 #endif
 
@@ -837,7 +703,7 @@ void HeatProtect() {
 #endif
                             cur_pwr = 0;
                             pwr_offset = 0;
-                            pwr_lmt_done = pwr_lmt_sec = 0;
+                            pwr_lmt_done = pwr_ramp_idx = 0;
                             cnt = 0;
                         }
                     } else
@@ -850,9 +716,56 @@ void HeatProtect() {
     }
 }
 
-void PwrLMT() {
-    static uint8_t p_init = 1;
+#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
+#ifdef USE_TEMPERATURE_SENSOR
+#define PWR_RAMP_TEMP temp0
+#else
+#define PWR_RAMP_TEMP temperature
+#endif
+#endif
+
+// Soft-start shared by the SmartAudio and disarmed paths of PwrLMT(), one
+// step per 4Hz tick. 1W walks up pwr_ramp_curve and holds for as long as
+// the temperature rose more than PWR_RAMP_HOLD between two 2Hz samples.
+static void pwr_ramp_task(void) {
+#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
+    static int16_t t_ref;
+    static int16_t rise = 0;
+    int16_t t, p;
+#endif
+
+    if (!timer_4hz || !rf_delay_init_done)
+        return;
+
+#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
+    if (RF_POWER == 3 && pwr_ramp_idx < ARRAY_SIZE(pwr_ramp_curve)) {
+        t = PWR_RAMP_TEMP;
+        if (!pwr_ramp_idx) {
+            rise = 0;
+            t_ref = t;
+        } else if (timer_2hz) { // TempDetect() only samples at 2Hz
+            rise = t - t_ref;
+            t_ref = t;
+        }
+        if (rise > PWR_RAMP_HOLD)
+            return;
+
+        p = table_power[RF_FREQ][3] - pwr_ramp_curve[pwr_ramp_idx++] + pwr_offset;
+        SPI_Write(0x6, 0xFF0, 0x00000018);  // set page
+        SPI_Write(0x3, 0xD1C, (uint32_t)p); // digital offset
+        SPI_Write(0x3, 0x330, 0x31F);       // analog offset 1W
+        return;
+    }
+#endif
+
+    DM6300_SetPower(RF_POWER, RF_FREQ, pwr_offset);
+    cur_pwr = RF_POWER;
+    pwr_lmt_done = 1;
+    pwr_ramp_idx = 0;
+    Prompt();
+}
 
+void PwrLMT() {
     if (cur_pwr > POWER_MAX)
         return;
 
@@ -860,46 +773,10 @@ void PwrLMT() {
     if (SA_lock) { // Smart Audio
         HeatProtect();
         if (!heat_protect) {
-            if (pwr_lmt_done == 0) {
-                if (pwr_tflg) {
-                    pwr_tflg = 0;
-                    pwr_lmt_sec++;
-
-#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
-                    // test: power plus every sec
-                    if (pwr_lmt_sec >= 3) {
-                        if (RF_POWER == 3) {
-                            if (p_init) {
-                                p = table_power[RF_FREQ][3] - 0x1C;
-                                p_init = 0;
-                            }
-
-                            SPI_Write(0x6, 0xFF0, 0x00000018);
-
-                            if (p >= table_power[RF_FREQ][3]) {
-                                p = table_power[RF_FREQ][3];
-                            } else {
-                                p += 0x4;
-                            }
-
-                            SPI_Write(0x3, 0xD1C, (uint32_t)p);
-                            SPI_Write(0x3, 0x330, 0x31F); // 1W
-                        }
-                    }
-#endif
-                    if (pwr_lmt_sec >= PWR_LMT_SEC) {
-                        DM6300_SetPower(RF_POWER, RF_FREQ, pwr_offset);
-                        cur_pwr = RF_POWER;
-                        pwr_lmt_done = 1;
-                        pwr_lmt_sec = 0;
-                        // test: power init reset
-                        p_init = 1;
-                        Prompt();
-                    }
-                }
-            } else {
+            if (pwr_lmt_done == 0)
+                pwr_ramp_task();
+            else
                 PowerAutoSwitch();
-            }
         }
     }
     /*
@@ -924,46 +801,10 @@ void PwrLMT() {
         } else {
             HeatProtect();
             if (!heat_protect) {
-                if (pwr_lmt_done == 0) {
-                    if (pwr_tflg) {
-                        pwr_tflg = 0;
-                        pwr_lmt_sec++;
-
-#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
-                        // test: power plus every sec
-                        if (pwr_lmt_sec >= 3) {
-                            if (RF_POWER == 3) {
-                                if (p_init) {
-                                    p = table_power[RF_FREQ][3] - 0x1C;
-                                    p_init = 0;
-                                }
-                                SPI_Write(0x6, 0xFF0, 0x00000018); // set page
-
-                                if (p >= table_power[RF_FREQ][3])
-                                    p = table_power[RF_FREQ][3];
-                                else {
-                                    p += 0x4;
-                                }
-                                SPI_Write(0x3, 0xD1C, (uint32_t)(p + pwr_offset)); // digital offset
-                                SPI_Write(0x3, 0x330, 0x31F);                      // analog offset 1W
-                            }
-                        }
-#endif // HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
-
-                        if (pwr_lmt_sec >= PWR_LMT_SEC) {
-                            DM6300_SetPower(RF_POWER, RF_FREQ, pwr_offset);
-                            cur_pwr = RF_POWER;
-                            pwr_lmt_done = 1;
-                            pwr_lmt_sec = 0;
-                            // test: power init reset
-                            p_init = 1;
-
-                            Prompt();
-                        }
-                    }
-                } else {
+                if (pwr_lmt_done == 0)
+                    pwr_ramp_task();
+                else
                     PowerAutoSwitch();
-                }
             }
         }
     }
@@ -983,61 +824,101 @@ void Flicker_LED(uint8_t n) {
     led_status = ON;
 }
 
-void video_detect(void) {
-    static uint16_t last_sec = 0;
-    static uint8_t sec = 0;
-    uint16_t video_type_id = 0;
-    uint8_t i;
+// Formats video_detect() tries when a camera behind the TC3587 without a
+// RunCam id loses lock, starting after the last one that locked
+CODE_SEG const vdo_hypo_t vdo_hypo_tab[] = {
+    {VDO_FMT_720P60, VDO_MODE_720P60},
+    {VDO_FMT_720P50, VDO_MODE_720P50},
+};
 
-    if (last_sec != seconds) {
-        last_sec = seconds;
-        sec++;
+// 8Hz video lock monitor. cameraLost is set after VDO_LOST_MISS bad reads in
+// a row and clears on the first good one. A camera without a RunCam id (TC3587
+// targets only, the TP9950 sets its own format) is re-initialised with each
+// format hypothesis while lost. Each gets `dwell` ticks to lock; dwell doubles
+// every full pass up to VDO_DWELL_MAX.
+void video_detect(void) {
+    static uint8_t miss = 0;
+    static uint8_t tick = 0;
+    static uint8_t dwell = VDO_DWELL_MIN;
+    static uint8_t hypo = 0;
+    static uint8_t good = 0; // vdo_hypo_tab index that locked last
+    uint8_t i, bad;
+
+    if (!timer_8hz || heat_protect)
+        return;
 
-        if (heat_protect)
-            return;
 #if (0)
-        if (camera_type == CAMERA_TYPE_RESERVED) {
-            cameraLost = 1;
-            return;
-        }
+    if (camera_type == CAMERA_TYPE_RESERVED) {
+        cameraLost = 1;
+        return;
+    }
+#endif
+#ifdef USE_TP9950
+    if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1 ||
+        camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2 ||
+        camera_type == CAMERA_TYPE_RUNCAM_NANO_90 ||
+        camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3 ||
+        camera_type == CAMERA_TYPE_RESERVED) {
+        bad = (I2C_Read16(ADDR_TC3587, 0x006A) != 0x1E); // YUV422
+    } else {
+        bad = (ReadReg(0, 0x02) >> 4) & 1;
+        if (camera_type == CAMERA_TYPE_OUTDATED)
+            bad |= (I2C_Read8(ADDR_TP9950, 0x01) != 0x7E);
+    }
+#else
+    if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1 ||
+        camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2 ||
+        camera_type == CAMERA_TYPE_RUNCAM_NANO_90 ||
+        camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3) {
+        bad = (I2C_Read16(ADDR_TC3587, 0x006A) != 0x1E); // YUV422
+    } else {
+        bad = (ReadReg(0, 0x02) >> 4) & 1; // same check as camera_mode_detect()
+    }
 #endif
-        if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1 ||
-            camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2 ||
-            camera_type == CAMERA_TYPE_RUNCAM_NANO_90 ||
-            camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3 ||
-            camera_type == CAMERA_TYPE_RESERVED) {
-            i = 0;
-            video_type_id = 0;
-            while (video_type_id == 0) {
-                video_type_id = I2C_Read16(ADDR_TC3587, 0x006A);
-                i++;
-                if (i == 10)
-                    break;
-                WAIT(1);
-            }
-            cameraLost = (video_type_id != 0x1E); // YUV422
-            return;
-        }
 
-        cameraLost = (ReadReg(0, 0x02) >> 4) & 1;
-        if (camera_type == CAMERA_TYPE_OUTDATED) {
-            cameraLost |= (I2C_Read8(ADDR_TP9950, 0x01) != 0x7E);
-            return;
-        }
+    if (!bad)
+        miss = 0;
+    else if (miss < VDO_LOST_MISS)
+        miss++;
+    cameraLost = (miss >= VDO_LOST_MISS);
 
-        if (sec == 3) {
-            sec = 0;
-            if (cameraLost) { // video loss
-                if (video_format == VDO_FMT_720P50) {
-                    Set_720P60(IS_RX);
-                    video_format = VDO_FMT_720P60;
-                } else if (video_format == VDO_FMT_720P60) {
-                    Set_720P50(IS_RX);
-                    video_format = VDO_FMT_720P50;
-                }
-            }
+#ifdef USE_TP9950
+    return;
+#else
+    if (camera_type != CAMERA_TYPE_OUTDATED && camera_type != CAMERA_TYPE_RESERVED)
+        return; // format fixed by the camera
+
+    if (!cameraLost) {
+        for (i = 0; i < ARRAY_SIZE(vdo_hypo_tab); i++) {
+            if (vdo_hypo_tab[i].fmt == video_format)
+                good = i;
+        }
+        if (camera_type == CAMERA_TYPE_RESERVED && !bad) {
+            // recovered a camera that never locked at boot
+            camera_type = CAMERA_TYPE_OUTDATED;
+            I2C_Write8_Wait(10, ADDR_EEPROM, EEP_ADDR_VDO_FMT, video_format);
         }
+        tick = hypo = 0;
+        dwell = VDO_DWELL_MIN;
+        return;
+    }
+
+    if (++tick < dwell)
+        return;
+    tick = 0;
+
+    // hypothesis 0 is the last good format, then the rest of the table in order
+    if (++hypo >= ARRAY_SIZE(vdo_hypo_tab)) {
+        hypo = 0;
+        if (dwell < VDO_DWELL_MAX)
+            dwell <<= 1;
     }
+    i = (good + hypo) % ARRAY_SIZE(vdo_hypo_tab);
+    // as camera_mode_detect(), the TC3587 may have browned out with the camera
+    Init_TC3587(0);
+    Set_VideoMode(IS_RX, vdo_hypo_tab[i].mode);
+    video_format = vdo_hypo_tab[i].fmt;
+#endif
 }
 
 void Imp_RF_Param() {
@@ -1442,7 +1323,6 @@ void timer_task() {
         timer_cnt &= 15;
         if (timer_cnt == 15) { // every second, 1Hz
             btn1_tflg = 1;
-            pwr_tflg = 1;
             cfg_tflg = 1;
             seconds++;
             pwr_sflg = 1;
@@ -1498,7 +1378,7 @@ void RF_Delay_Init() {
         rf_delay_init_done = 1;
 
     if (last_SA_lock) {
-        pwr_lmt_sec = PWR_LMT_SEC;
+        pwr_ramp_idx = 0xFF; // skip the soft-start ramp
         if (SA_lock) {
             if (pwr_init == POWER_MAX + 2) { // 0mW
                 RF_POWER = POWER_MAX + 2;
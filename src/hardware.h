@@ -16,6 +16,43 @@ typedef enum {
     BW_17M
 } BWType_e;
 
+typedef enum {
+    VDO_MODE_720P50,
+    VDO_MODE_720P60,
+    VDO_MODE_720P60_8BIT,
+    VDO_MODE_960x720P60,
+    VDO_MODE_720P30,
+    VDO_MODE_720P30_43,
+    VDO_MODE_540P90,
+    VDO_MODE_540P90_CROP,
+    VDO_MODE_540P60,
+    VDO_MODE_1080P30,
+    VDO_MODE_NUM
+} vdo_mode_e;
+
+#define VDO_REG_NUM 13 // registers per row of vdo_reg_tab
+
+typedef struct {
+    uint8_t fmt;  // video_format_e
+    uint8_t mode; // vdo_mode_e
+} vdo_hypo_t;
+
+#define VDO_LOST_MISS 3  // bad 8Hz reads in a row before the camera counts as lost
+#define VDO_DWELL_MIN 2  // 8Hz ticks a format hypothesis gets to lock
+#define VDO_DWELL_MAX 16
+
+typedef struct {
+    int16_t soft_max; // PI derate starts above this
+    uint8_t lead;     // seconds of temperature rise to look ahead
+    uint8_t kp_shift; // derate = (err >> kp_shift) + (integral >> ki_shift)
+    uint8_t ki_shift;
+    uint8_t hyst;     // offset steps down only this far below the step
+} thermal_cal_t;
+
+#define THERMAL_RATE_MAX  0x400
+#define THERMAL_INTEG_MAX 0x800
+#define PWR_RAMP_HOLD     0x30 // temperature rise (x4) per 2Hz sample that holds the 1W ramp
+
 // eeprom parameter
 #define EEP_ADDR_TAB1         0x00 // 0x00 - 0x1F
 #define EEP_ADDR_TAB2         0x20 // 0x20 - 0x3F
@@ -25,6 +62,7 @@ typedef enum {
 // profile 2: 0x52~0x61
 // profile 3: 0x62~0x71
 #define EEP_ADDR_CAM_SETTING  0x42
+#define EEP_ADDR_CAM_CRC      0x72 // 0x72~0x74, crc8 of profile 1~3
 #define EEP_ADDR_RF_FREQ      0x80
 #define EEP_ADDR_RF_POWER     0x81
 #define EEP_ADDR_LPMODE       0x82
@@ -38,6 +76,7 @@ typedef enum {
 #define EEP_ADDR_LOWBAND_LOCK 0x8C
 #define EEP_ADDR_SHORTCUT     0x8D
 #define EEP_ADDR_CAM_RATIO    0x8E
+#define EEP_ADDR_VDO_FMT      0x8F // last 720P50/60 format that locked
 #define EEP_ADDR_TAB3         0xA0 // 0xA0 - 0xBF
 #define EEP_ADDR_DCOC1        0xC0 // 0xC0 - 0xC4
 #define EEP_ADDR_DCOC_EN      0xC0
@@ -85,15 +124,17 @@ void Imp_RF_Param();
 void CFG_Back();
 void check_eeprom();
 
-void Set_720P50(uint8_t page);
-void Set_720P60(uint8_t page);
-void Set_540P90(uint8_t page);
-void Set_540P90_crop(uint8_t page);
-void Set_960x720P60(uint8_t page);
-void Set_720P30(uint8_t page, uint8_t is_43);
-void Set_540P60(uint8_t page);
-void Set_1080P30(uint8_t page);
-void Set_720P60_8bit(uint8_t page);
+void Set_VideoMode(uint8_t page, uint8_t mode);
+void Set_VideoMode_invalidate(void);
+#define Set_720P50(page)        Set_VideoMode(page, VDO_MODE_720P50)
+#define Set_720P60(page)        Set_VideoMode(page, VDO_MODE_720P60)
+#define Set_540P90(page)        Set_VideoMode(page, VDO_MODE_540P90)
+#define Set_540P90_crop(page)   Set_VideoMode(page, VDO_MODE_540P90_CROP)
+#define Set_960x720P60(page)    Set_VideoMode(page, VDO_MODE_960x720P60)
+#define Set_720P30(page, is_43) Set_VideoMode(page, (is_43) ? VDO_MODE_720P30_43 : VDO_MODE_720P30)
+#define Set_540P60(page)        Set_VideoMode(page, VDO_MODE_540P60)
+#define Set_1080P30(page)       Set_VideoMode(page, VDO_MODE_1080P30)
+#define Set_720P60_8bit(page)   Set_VideoMode(page, VDO_MODE_720P60_8BIT)
 
 void Flicker_LED(uint8_t n);
 void LED_Flip();
@@ -133,7 +174,7 @@ extern uint8_t fc_lock;
 extern uint8_t vtx_pit;
 extern uint8_t vtx_pit_save;
 extern uint8_t SA_lock;
-extern uint8_t pwr_lmt_sec;
+extern uint8_t pwr_ramp_idx;
 extern uint8_t pwr_lmt_done;
 
 extern uint8_t cur_pwr;
@@ -6,7 +6,6 @@
 
 BIT_TYPE btn1_tflg = 0;
 BIT_TYPE pwr_sflg = 0; // power autoswitch flag
-BIT_TYPE pwr_tflg = 0;
 BIT_TYPE cfg_tflg = 0;
 BIT_TYPE timer_2hz = 0;
 BIT_TYPE timer_4hz = 0;
@@ -63,5 +62,9 @@ void CPU_init(void) {
                // [1]   enable timer0 interupt   0
                // [0]   enable INT0   interupt   0
 #endif
+#ifdef USE_SMARTAUDIO_SW
+    IP = 0x02; // Timer 0=higher priority for the SA bit timing, UART0 = low
+#else
     IP = 0x10; // UART0=higher priority, Timer 0 = low
+#endif
 }
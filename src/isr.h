@@ -7,7 +7,6 @@
 
 extern BIT_TYPE btn1_tflg;
 extern BIT_TYPE pwr_sflg;
-extern BIT_TYPE pwr_tflg;
 extern BIT_TYPE cfg_tflg;
 extern uint16_t seconds;
 extern IDATA_SEG volatile uint16_t timer_ms10x;
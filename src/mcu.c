@@ -25,18 +25,34 @@ BIT_TYPE int0_req = 0;
 BIT_TYPE int1_req = 0;
 
 void Timer0_isr(void) INTERRUPT(1) {
-    TH0 = 138;
-
 #ifdef USE_SMARTAUDIO_SW
+    static uint8_t phase = 0;
+
     if (SA_config) {
+        // 3 ticks per SA bit. The reloads 177/177/178 (79+79+78 = 2 * 118)
+        // span two normal periods, so timer_ms10x counts 2 ticks out of 3.
+        TH0 = (phase == 2) ? 178 : 177;
         if (suart_tx_en) {
             // TH0 = 139;
             suart_txint();
         } else
             suart_rxint();
+
+        if (phase)
+            timer_ms10x++;
+        phase++;
+        if (phase == 3)
+            phase = 0;
+        return;
     }
+    suart_idleint();
 #endif
 
+    TH0 = 138;
+#ifdef USE_SMARTAUDIO_HW
+    if (suart_tx_en)
+        suart_txint();
+#endif
     timer_ms10x++;
 }
 
@@ -52,7 +68,7 @@ void Ext1_isr(void) INTERRUPT(2) {
 }
 
 void UART0_isr() INTERRUPT(4) {
-    if (RI && (tr_tx_busy == 0)) { // RX int
+    if (RI) { // RX int
         RI = 0;
         RS_buf[RS_in++] = SBUF0;
         if (RS_in >= BUF_MAX)
@@ -92,16 +108,26 @@ void UART1_isr() INTERRUPT(6) {
 #else
 void UART1_isr() INTERRUPT(6) {
 
-    if (RI1 && (tr_tx_busy == 0)) { // RX int
+    if (RI1) { // RX int
         RI1 = 0;
-        RS_buf1[RS_in1++] = SBUF1;
-        if (RS_in1 >= BUF1_MAX)
-            RS_in1 = 0;
+#ifdef USE_TRAMP
+        if (!tramp_is_echo(SBUF1))
+#endif
+        {
+            RS_buf1[RS_in1++] = SBUF1;
+            if (RS_in1 >= BUF1_MAX)
+                RS_in1 = 0;
+        }
     }
 
     if (TI1) { // TX int
         TI1 = 0;
-        RS_Xbusy1 = 0;
+#ifdef USE_TRAMP
+        if (tr_tx_busy)
+            tramp_txint();
+        else
+#endif
+            RS_Xbusy1 = 0;
     }
 }
 #endif
@@ -160,8 +186,7 @@ void main(void) {
     while (1) {
         timer_task();
 #if defined USE_SMARTAUDIO_SW
-        while (SA_task())
-            ;
+        SA_task();
 #elif defined USE_SMARTAUDIO_HW
         while (SA_task()) {
             if (SA_timeout())
@@ -187,6 +212,7 @@ void main(void) {
             PwrLMT();     // RF power ctrl
             msp_task();
             Update_EEP_LifeTime();
+            camera_eep_task();
             uart_baudrate_detect();
             runcam_shutter_fix(seconds);
         }
@@ -7,6 +7,7 @@
 #include "hardware.h"
 #include "i2c.h"
 #include "i2c_device.h"
+#include "msp_displayport.h"
 #include "print.h"
 #include "sfr_ext.h"
 #include "spi.h"
@@ -44,6 +45,8 @@ void MonHelp(void) {
     debugf("\r\n   er               : Read  rf_tab[freq][pwr]");
     debugf("\r\n   ea               : rf_tab[freq][pwr]++");
     debugf("\r\n   es               : rf_tab[freq][pwr]--");
+    debugf("\r\n   msp              : MSP request round trip stats");
+    debugf("\r\n   temp             : AUXADC temperature min/max");
     debugf("\r\n   h                : Help");
     debugf("\r\n");
 }
@@ -195,6 +198,26 @@ void MonEE(uint8_t op, uint8_t d) {
 }
 #endif
 
+#ifdef _DEBUG_MODE
+void MonMspStats(void) {
+    uint8_t i;
+    // round trip times in timer0 ticks (~0.1ms)
+    debugf("\r\nreq  last   min   max   avg   rx    to");
+    for (i = 0; i < MSP_REQ_NUM; i++) {
+        debugf("\r\n%d    %d  %d  %d  %d  %d  %d", (uint16_t)i,
+               msp_req[i].rtt_last, msp_req[i].rtt_min, msp_req[i].rtt_max,
+               msp_req[i].rtt_avg, msp_req[i].replies, msp_req[i].timeouts);
+    }
+}
+#endif
+
+#ifdef _DEBUG_MODE
+void MonTempStats(void) {
+    // extremes of the raw DM6300_ReadTemp() samples since power-on
+    debugf("\r\nauxadc temp min %d  max %d", auxadc_temp_min, auxadc_temp_max);
+}
+#endif
+
 void Monitor(void) {
 #ifdef _DEBUG_MODE
     if (!MonGetCommand())
@@ -290,7 +313,11 @@ void Monitor(void) {
             debugf("\r\nVerbose on");
         else
             debugf("\r\nVerbose off");
-    } else if (!stricmp(argv[0], "h"))
+    } else if (!stricmp(argv[0], "msp"))
+        MonMspStats();
+    else if (!stricmp(argv[0], "temp"))
+        MonTempStats();
+    else if (!stricmp(argv[0], "h"))
         MonHelp();
     else
         debugf("\r\nInvalid Command...");
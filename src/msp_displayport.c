@@ -15,7 +15,9 @@
 
 uint8_t osd_buf[OSD_CANVAS_HD_VMAX1][OSD_CANVAS_HD_HMAX1];
 uint8_t loc_buf[OSD_CANVAS_HD_VMAX1][7];
-uint8_t page_extend_buf[OSD_CANVAS_HD_VMAX1][7];
+uint8_t attr_buf[OSD_PLANE_NUM][OSD_CANVAS_HD_VMAX1][7]; // one bit per cell and plane
+uint8_t osd_grp_used[OSD_CANVAS_HD_VMAX1];                // 8-column groups written since the last clear
+uint8_t osd_blink_off = 0;
 uint8_t tx_buf[TXBUF_SIZE]; // buffer for sending data to VRX
 uint8_t dptxbuf[256];
 uint8_t dptx_rptr, dptx_wptr;
@@ -30,8 +32,21 @@ uint8_t fc_variant[4] = {0xff, 0xff, 0xff, 0xff};
 uint8_t fontType = 0x00;
 uint8_t resolution = SD_3016;
 uint8_t resolution_last = HD_5018;
-
-uint8_t msp_rx_buf[64]; // from FC responding status|variant|rc commands
+uint8_t osd_hmax = OSD_CANVAS_SD_HMAX; // live part of osd_buf, see osd_canvas_set()
+uint8_t osd_vmax = OSD_CANVAS_SD_VMAX;
+uint8_t osd_mask_len = 4; // mask/page bytes per row
+
+// from FC responding status|variant|rc commands and displayport frames (v1 and v2)
+XDATA_SEG uint8_t msp_rx_buf[MSP_RX_BUF_SIZE];
+uint16_t msp_rx_oversize = 0; // frames dropped for not fitting msp_rx_buf
+
+#ifdef USE_TELEMETRY
+XDATA_SEG telem_entry_t telem_ring[TELEM_RING_SIZE];
+uint8_t telem_head = 0; // next slot to write
+uint8_t telem_count = 0;
+uint16_t telem_sec = 0; // seconds at the newest sample
+uint8_t dptx_peak = 0;
+#endif
 
 uint8_t vtx_channel;
 uint8_t vtx_power;
@@ -63,7 +78,40 @@ uint8_t msp_rcv = 0;
 uint16_t tick_8hz = 0;
 uint16_t msp_rcv_tick_8hz = 0;
 
-uint8_t msp_rbuf[64];
+CODE_SEG const uint8_t msp_req_cmd[MSP_REQ_NUM] = {
+    MSP_FC_VARIANT,
+    MSP_GET_VTX_CONFIG,
+    MSP_GET_OSD_CANVAS,
+    MSP_STATUS,
+    MSP_RC,
+    MSP_SET_VTX_CONFIG};
+XDATA_SEG msp_req_t msp_req[MSP_REQ_NUM];
+CODE_SEG const uint8_t osd_bit_tab[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80}; // avoids variable shifts
+CODE_SEG const uint8_t osd_head_mask[8] = {0xff, 0xfe, 0xfc, 0xf8, 0xf0, 0xe0, 0xc0, 0x80}; // bits >= n
+CODE_SEG const uint8_t osd_tail_mask[8] = {0x01, 0x03, 0x07, 0x0f, 0x1f, 0x3f, 0x7f, 0xff}; // bits <= n
+uint8_t osd_row_pending[3]; // changed rows sent ahead of the round-robin refresh
+
+#ifdef USE_OSD_BACK_BUFFER
+// FC writes are staged here and copied to osd_buf on SUBCMD_DRAW
+uint8_t osd_back_buf[OSD_CANVAS_HD_VMAX1][OSD_CANVAS_HD_HMAX1];
+uint8_t loc_back_buf[OSD_CANVAS_HD_VMAX1][7];
+uint8_t attr_back_buf[OSD_PLANE_NUM][OSD_CANVAS_HD_VMAX1][7];
+uint8_t osd_back_grp_used[OSD_CANVAS_HD_VMAX1];
+uint8_t osd_row_dirty[3]; // staged rows changed since the last commit
+#define OSD_WR_BUF  osd_back_buf
+#define LOC_WR_BUF  loc_back_buf
+#define ATTR_WR_BUF attr_back_buf
+#define GRP_WR_BUF  osd_back_grp_used
+#else
+#define OSD_WR_BUF  osd_buf
+#define LOC_WR_BUF  loc_buf
+#define ATTR_WR_BUF attr_buf
+#define GRP_WR_BUF  osd_grp_used
+#endif
+uint8_t msp_poll_cnt[MSP_POLL_NUM];
+uint8_t msp_arm_fast_cnt = 0; // fast STATUS polling after an arm state change
+uint8_t vtx_cfg_power = 0;    // last msp_set_vtx_config() request, for resend
+uint8_t vtx_cfg_resend = 0;   // 0: vtx_table_task() retries its own request
 
 uint8_t mspVtxLock = 0;
 uint8_t init_table_supported = 0;
@@ -153,36 +201,34 @@ uint8_t hdzero_dynamic_osd_refresh_adapter(uint8_t t1) {
 
 void msp_task() {
     uint8_t len;
+    uint8_t row;
     static uint16_t last_sec = 0;
     static uint8_t t1 = 0;
-    static uint8_t vmax = OSD_CANVAS_SD_VMAX;
 
     DP_tx_task();
 
     // decide by osd_frame size/rate and dptx rate
-    if (msp_read_one_frame()) {
-        if (resolution == HD_5018) {
-            vmax = OSD_CANVAS_HD_VMAX0;
-        } else if (resolution == HD_5320) {
-            vmax = OSD_CANVAS_HD_VMAX1;
-        } else {
-            vmax = OSD_CANVAS_SD_VMAX;
-        }
-    }
+    msp_read_one_frame();
 
     if (osd_ready) {
         // send osd
-        len = get_tx_data_osd(t1);
-        if (hdzero_dynamic_osd_refresh_adapter(t1))
+        row = osd_next_row(t1);
+        len = get_tx_data_osd(row);
+        if (hdzero_dynamic_osd_refresh_adapter(row))
             insert_tx_buf(len);
-        t1++;
-        if (t1 >= vmax)
-            t1 = 0;
+        if (row == t1) {
+            t1++;
+            if (t1 >= osd_vmax)
+                t1 = 0;
+        }
     }
 
     // send param to FC -- 8HZ
     // send param to VRX -- 8HZ
     // detect fc lost
+    if (timer_2hz)
+        osd_blink_off = !osd_blink_off;
+
     if (timer_8hz) {
         len = get_tx_data_5680();
         insert_tx_buf(len);
@@ -204,6 +250,14 @@ void msp_task() {
         }
     }
 
+#ifdef INIT_VTX_TABLE
+    vtx_table_task();
+#endif
+
+#ifdef USE_TELEMETRY
+    telem_task();
+#endif
+
     // set_vtx
     set_vtx_param();
 }
@@ -211,11 +265,13 @@ void msp_task() {
 uint8_t msp_read_one_frame() {
     static uint8_t state = MSP_HEADER_START;
     static uint8_t cur_cmd = CUR_OTHERS;
+    static uint8_t cmd_u8 = 0;
     static uint8_t length, osd_len;
     static uint8_t ptr = 0; // write ptr of msp_rx_buf
     static uint8_t crc = 0;
     static uint16_t cmd_u16 = 0;
     static uint16_t len_u16 = 0;
+    static uint16_t payload_len = 0;
 
     uint8_t i, ret, full_frame, rx;
 
@@ -259,11 +315,12 @@ uint8_t msp_read_one_frame() {
             crc = rx;
             state = MSP_CMD;
             length = rx;
-            osd_len = rx - 4;
+            osd_len = (rx >= 4) ? rx - 4 : 0; // as the v2 payload_len guard
             break;
 
         case MSP_CMD:
             crc ^= rx;
+            cmd_u8 = rx;
             if (rx == MSP_DISPLAYPORT) {
                 cur_cmd = CUR_DISPLAYPORT;
             } else if (rx == MSP_RC) {
@@ -288,7 +345,6 @@ uint8_t msp_read_one_frame() {
         case MSP_RX1:
             crc ^= rx;
             msp_rx_buf[ptr++] = rx;
-            ptr &= 63;
             length--;
             if (length == 0)
                 state = MSP_CRC1;
@@ -310,6 +366,10 @@ uint8_t msp_read_one_frame() {
                     parse_get_osd_canvas();
                 else if (cur_cmd == CUR_DISPLAYPORT)
                     ret = parse_displayport(osd_len);
+                msp_req_done(cmd_u8);
+#ifdef INIT_VTX_TABLE
+                vtx_table_ack(cmd_u8);
+#endif
                 full_frame = 1;
                 if ((fc_lock & FC_VTX_CONFIG_LOCK) && (fc_lock & FC_VARIANT_LOCK) && (fc_lock & FC_INIT_VTX_TABLE_LOCK) == 0) {
                     fc_lock |= FC_INIT_VTX_TABLE_LOCK;
@@ -365,7 +425,12 @@ uint8_t msp_read_one_frame() {
         case MSP_LEN_H:
             crc = crc8tab[crc ^ rx];
             len_u16 += ((uint16_t)rx << 8);
-            if (len_u16 == 0) {
+            payload_len = len_u16;
+            if (len_u16 > MSP_RX_BUF_SIZE) {
+                // reject instead of wrapping around msp_rx_buf
+                msp_rx_oversize++;
+                state = MSP_HEADER_START;
+            } else if (len_u16 == 0) {
                 state = MSP_CRC2;
             } else {
                 ptr = 0;
@@ -376,7 +441,6 @@ uint8_t msp_read_one_frame() {
         case MSP_RX2:
             crc = crc8tab[crc ^ rx];
             msp_rx_buf[ptr++] = rx;
-            ptr &= 63;
             len_u16--;
             if (len_u16 == 0) {
                 state = MSP_CRC2;
@@ -402,8 +466,20 @@ uint8_t msp_read_one_frame() {
                 case MSP_VTX_GET_HW_FAULTS:
                     msp_send_vtx_hw_faults();
                     break;
+#ifdef USE_TELEMETRY
+                case MSP_VTX_GET_TELEMETRY:
+                    msp_send_vtx_telemetry();
+                    break;
+#endif
                 case MSP_GET_VTX_CONFIG:
                     parseMspVtx_V2();
+                    break;
+                case MSP_DISPLAYPORT:
+                    if (payload_len >= 4)
+                        ret = parse_displayport(payload_len - 4);
+                    else
+                        ret = parse_displayport(0);
+                    break;
                 default:
                     break;
                 }
@@ -421,26 +497,188 @@ uint8_t msp_read_one_frame() {
     return ret;
 }
 
+// Only the live canvas is cleared; the rest is wiped by osd_canvas_set()
 void clear_screen() {
-    memset(osd_buf, 0x20, sizeof(osd_buf));
-    memset(loc_buf, 0x00, sizeof(loc_buf));
-    memset(page_extend_buf, 0x00, sizeof(page_extend_buf));
+    uint8_t i, p;
+    for (i = 0; i < osd_vmax; i++) {
+        memset(osd_buf[i], 0x20, osd_hmax);
+        memset(loc_buf[i], 0x00, osd_mask_len);
+        for (p = 0; p < OSD_PLANE_NUM; p++)
+            memset(attr_buf[p][i], 0x00, osd_mask_len);
+    }
+    memset(osd_grp_used, 0, sizeof(osd_grp_used));
+    memset(osd_row_pending, 0, sizeof(osd_row_pending));
+#ifdef USE_OSD_BACK_BUFFER
+    osd_stage_clear();
+    memset(osd_row_dirty, 0, sizeof(osd_row_dirty));
+#endif
+}
+
+// pending rows go out first, the others keep the round-robin refresh
+uint8_t osd_next_row(uint8_t t1) {
+    uint8_t i, b;
+    for (i = 0; i < osd_vmax; i++) {
+        b = osd_bit_tab[i & 0x07];
+        if (osd_row_pending[i >> 3] & b) {
+            osd_row_pending[i >> 3] &= ~b;
+            return i;
+        }
+    }
+    return t1;
+}
+
+#ifdef USE_OSD_BACK_BUFFER
+void osd_stage_clear() {
+    uint8_t i, p;
+    for (i = 0; i < osd_vmax; i++) {
+        memset(osd_back_buf[i], 0x20, osd_hmax);
+        memset(loc_back_buf[i], 0x00, osd_mask_len);
+        for (p = 0; p < OSD_PLANE_NUM; p++)
+            memset(attr_back_buf[p][i], 0x00, osd_mask_len);
+        osd_row_dirty[i >> 3] |= osd_bit_tab[i & 0x07];
+    }
+    memset(osd_back_grp_used, 0, sizeof(osd_back_grp_used));
+}
+
+// copy the rows written since the last SUBCMD_DRAW to the front buffer
+void osd_commit() {
+    uint8_t i, b, p;
+    for (i = 0; i < osd_vmax; i++) {
+        b = osd_bit_tab[i & 0x07];
+        if (osd_row_dirty[i >> 3] & b) {
+            memcpy(osd_buf[i], osd_back_buf[i], osd_hmax);
+            memcpy(loc_buf[i], loc_back_buf[i], osd_mask_len);
+            for (p = 0; p < OSD_PLANE_NUM; p++)
+                memcpy(attr_buf[p][i], attr_back_buf[p][i], osd_mask_len);
+            osd_grp_used[i] = osd_back_grp_used[i];
+            osd_row_pending[i >> 3] |= b;
+        }
+    }
+    memset(osd_row_dirty, 0, sizeof(osd_row_dirty));
 }
+#endif
+
+void osd_canvas_set(uint8_t res) {
+    uint8_t hmax, vmax;
+
+    resolution = res;
+    if (res == HD_5018) {
+        hmax = OSD_CANVAS_HD_HMAX0;
+        vmax = OSD_CANVAS_HD_VMAX0;
+        osd_menu_offset = 8;
+    } else if (res == HD_5320) {
+        hmax = OSD_CANVAS_HD_HMAX1;
+        vmax = OSD_CANVAS_HD_VMAX1;
+        osd_menu_offset = 0;
+    } else {
+        hmax = OSD_CANVAS_SD_HMAX;
+        vmax = OSD_CANVAS_SD_VMAX;
+        osd_menu_offset = 0;
+    }
 
-void write_string(uint8_t rx, uint8_t row, uint8_t col, uint8_t page_extend) {
-    if (disp_mode == DISPLAY_OSD) {
-        if (row < OSD_CANVAS_HD_VMAX1 && col < OSD_CANVAS_HD_HMAX1) {
-            osd_buf[row][col] = rx;
-            if (page_extend)
-                page_extend_buf[row][col >> 3] |= (1 << (col & 0x07));
+    if (hmax != osd_hmax || vmax != osd_vmax) {
+        // cells outside the old canvas may hold stale menu text
+        memset(osd_buf, 0x20, sizeof(osd_buf));
+        memset(loc_buf, 0x00, sizeof(loc_buf));
+        memset(attr_buf, 0x00, sizeof(attr_buf));
+        memset(osd_grp_used, 0, sizeof(osd_grp_used));
+#ifdef USE_OSD_BACK_BUFFER
+        memset(osd_back_buf, 0x20, sizeof(osd_back_buf));
+        memset(loc_back_buf, 0x00, sizeof(loc_back_buf));
+        memset(attr_back_buf, 0x00, sizeof(attr_back_buf));
+        memset(osd_back_grp_used, 0, sizeof(osd_back_grp_used));
+#endif
+        osd_hmax = hmax;
+        osd_vmax = vmax;
+        osd_mask_len = (hmax + 7) >> 3;
+    }
+}
+
+// DisplayPort attribute byte to OSD_ATTR_* plane bits
+uint8_t osd_attr_decode(uint8_t attr, uint8_t is_btfl) {
+    uint8_t planes = 0;
+
+    // BTFL uses the font page bits for severity, not for the extended page
+    if (!is_btfl && (attr & DP_ATTR_PAGE))
+        planes |= OSD_ATTR_PAGE;
+    if (attr & DP_ATTR_BLINK)
+        planes |= OSD_ATTR_BLINK;
+    return planes;
+}
+
+// Set or clear every plane over cols col..col+n-1, one byte per 8 cells
+void osd_attr_span(uint8_t row, uint8_t col, uint8_t n, uint8_t planes) {
+    uint8_t first = col >> 3;
+    uint8_t last = (col + n - 1) >> 3;
+    uint8_t i, p, m;
+
+    for (i = first; i <= last; i++) {
+        m = 0xff;
+        if (i == first)
+            m &= osd_head_mask[col & 0x07];
+        if (i == last)
+            m &= osd_tail_mask[(col + n - 1) & 0x07];
+        for (p = 0; p < OSD_PLANE_NUM; p++) {
+            if (planes & osd_bit_tab[p])
+                ATTR_WR_BUF[p][row][i] |= m;
             else
-                page_extend_buf[row][col >> 3] &= (0xff - (1 << (col & 0x07)));
+                ATTR_WR_BUF[p][row][i] &= ~m;
         }
     }
 }
 
+void write_string(uint8_t *str, uint8_t row, uint8_t col, uint8_t n, uint8_t planes) {
+    if (disp_mode != DISPLAY_OSD)
+        return;
+    if (row >= OSD_CANVAS_HD_VMAX1 || col >= OSD_CANVAS_HD_HMAX1 || n == 0)
+        return;
+    if (n > OSD_CANVAS_HD_HMAX1 - col)
+        n = OSD_CANVAS_HD_HMAX1 - col;
+
+    memcpy(&OSD_WR_BUF[row][col], str, n);
+    osd_attr_span(row, col, n, planes);
+    GRP_WR_BUF[row] |= osd_head_mask[col >> 3] & osd_tail_mask[(col + n - 1) >> 3];
+#ifdef USE_OSD_BACK_BUFFER
+    osd_row_dirty[row >> 3] |= osd_bit_tab[row & 0x07];
+#endif
+}
+
+// Menu widgets draw into osd_buf, which retains what is on screen. Only cells
+// whose text changes are written, and their rows are queued to be sent first.
+void menu_char(uint8_t row, uint8_t col, uint8_t c) {
+    if (row >= OSD_CANVAS_HD_VMAX1 || col >= OSD_CANVAS_HD_HMAX1)
+        return;
+    if (osd_buf[row][col] != c) {
+        osd_buf[row][col] = c;
+        osd_grp_used[row] |= osd_bit_tab[col >> 3];
+        osd_row_pending[row >> 3] |= osd_bit_tab[row & 0x07];
+    }
+}
+
+void menu_label(uint8_t row, uint8_t col, const char *str) {
+    while (*str)
+        menu_char(row, col++, *str++);
+}
+
+// str padded with blanks to width, so a shorter value erases the longer one
+void menu_value(uint8_t row, uint8_t col, uint8_t width, const char *str) {
+    while (width--) {
+        if (*str)
+            menu_char(row, col++, *str++);
+        else
+            menu_char(row, col++, ' ');
+    }
+}
+
+void menu_cursor(uint8_t col, uint8_t first, uint8_t last, uint8_t sel) {
+    uint8_t i;
+    for (i = first; i <= last; i++)
+        menu_char(i, col, (i == sel) ? '>' : ' ');
+}
+
 void mark_loc(uint8_t row, uint8_t col) {
-    loc_buf[row][col >> 3] |= (1 << (col & 0x07));
+    if (row < OSD_CANVAS_HD_VMAX1 && col < OSD_CANVAS_HD_HMAX1)
+        LOC_WR_BUF[row][col >> 3] |= (1 << (col & 0x07));
 }
 
 void init_tx_buf() {
@@ -569,40 +807,54 @@ uint8_t get_tx_data_osd(uint8_t index) // prepare osd+data to VTX
 
     }
     */
-    uint8_t mask[7] = {0};
-    uint8_t i, t1;
+    uint8_t mask[7];
+    uint8_t i, j, t1;
     uint8_t ptr;
-    uint8_t hmax;
-    uint8_t len_mask;
     uint8_t page[7] = {0};
     uint8_t page_byte = 0;
     uint8_t num = 0;
+    uint8_t cols, msk, pe, hide, b, used;
+    uint8_t *src;
 
-    if (resolution == HD_5018) {
-        hmax = OSD_CANVAS_HD_HMAX0;
-        len_mask = 7;
-        ptr = 11;
-    } else if (resolution == HD_5320) {
-        hmax = OSD_CANVAS_HD_HMAX1;
-        len_mask = 7;
-        ptr = 11;
-    } else {
+    // every canvas but the HD ones carries 4 loc_flag bytes after the mask
+    if (osd_mask_len == 4)
         ptr = 12;
-        len_mask = 4;
-        hmax = OSD_CANVAS_SD_HMAX;
-    }
-
-    // string
-    for (i = 0; i < hmax; i++) {
-        t1 = osd_buf[index][i];
-        if ((t1 != 0x20) && (t1 != 0x00)) {
-            mask[i >> 3] |= (1 << (i & 0x07));
-            tx_buf[ptr] = t1;
+    else
+        ptr = 11;
 
-            page[num >> 3] |= ((page_extend_buf[index][i >> 3] >> (i & 0x07)) & 0x01) << (num & 0x07);
-            ptr++;
-            num++;
+    // string, packed in groups of 8 columns (one mask byte each). A group not
+    // written since the last clear is all blank and skipped without reading
+    // osd_buf. The camera menu draws with strcpy, so only trust it in OSD mode.
+    used = (disp_mode == DISPLAY_OSD) ? osd_grp_used[index] : 0xff;
+    src = osd_buf[index];
+    for (i = 0; i < osd_mask_len; i++) {
+        if (!(used & osd_bit_tab[i])) {
+            mask[i] = 0;
+            src += 8;
+            continue;
         }
+        cols = osd_hmax - (i << 3);
+        if (cols > 8)
+            cols = 8;
+        msk = 0;
+        pe = attr_buf[OSD_PLANE_PAGE][index][i];
+        if (osd_blink_off && (disp_mode == DISPLAY_OSD))
+            hide = attr_buf[OSD_PLANE_BLINK][index][i];
+        else
+            hide = 0;
+        for (j = 0; j < cols; j++) {
+            t1 = src[j];
+            b = osd_bit_tab[j];
+            if ((t1 != 0x20) && (t1 != 0x00) && !(hide & b)) {
+                msk |= b;
+                tx_buf[ptr++] = t1;
+                if (pe & b)
+                    page[num >> 3] |= osd_bit_tab[num & 0x07];
+                num++;
+            }
+        }
+        mask[i] = msk;
+        src += 8;
     }
 
     // page
@@ -625,7 +877,7 @@ uint8_t get_tx_data_osd(uint8_t index) // prepare osd+data to VTX
         tx_buf[3] = ptr - 4; // len
 
         // 0x20 flag
-        for (i = 0; i < len_mask; i++) {
+        for (i = 0; i < osd_mask_len; i++) {
             tx_buf[4 + i] = mask[i];
         }
 
@@ -729,6 +981,10 @@ void insert_tx_buf(uint8_t len) {
     }
     insert_tx_byte(crc0);
     insert_tx_byte(crc1);
+#ifdef USE_TELEMETRY
+    if ((uint8_t)(dptx_wptr - dptx_rptr) > dptx_peak)
+        dptx_peak = dptx_wptr - dptx_rptr;
+#endif
 }
 
 void msp_send_command(uint8_t dl, uint8_t version) {
@@ -769,43 +1025,159 @@ uint8_t msp_send_header_v2(uint16_t len, uint16_t msg) {
     return crc;
 }
 
+// Per-command poll schedule for the FC queries, in 1/8s ticks (0 = not polled).
+// VARIANT is polled until locked, then CONFIG, then the others.
+uint8_t msp_poll_interval(uint8_t idx) {
+    switch (idx) {
+    case MSP_REQ_FC_VARIANT:
+        return (fc_lock & FC_VARIANT_LOCK) ? 0 : 1;
+
+    case MSP_REQ_VTX_CONFIG:
+        if (!(fc_lock & FC_VARIANT_LOCK))
+            return 0;
+        if (!(fc_lock & FC_VTX_CONFIG_LOCK))
+            return 1;
+        return g_IS_ARMED ? 8 : 2;
+
+    case MSP_REQ_OSD_CANVAS:
+        // OSD_CANVAS not required for iNav
+        if (!(fc_lock & FC_VTX_CONFIG_LOCK) || (fc_lock & FC_OSD_CANVAS_LOCK) || msp_cmp_fc_variant("INAV"))
+            return 0;
+        return 1;
+
+    case MSP_REQ_STATUS:
+        if (!(fc_lock & FC_VTX_CONFIG_LOCK))
+            return 0;
+        if (msp_arm_fast_cnt)
+            return 1;
+        return g_IS_ARMED ? 4 : 2;
+
+    case MSP_REQ_RC:
+        // sticks are only needed while the CMS menu can be opened, or is
+        // still open so update_cms_menu() can leave it on the arm edge
+        if (!(fc_lock & FC_VTX_CONFIG_LOCK) || (g_IS_ARMED && cms_state == CMS_OSD))
+            return 0;
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
 // Send commands to the FC.
-// Ensure VARIANT is processed first, followed by CONFIG, then the others.
 void msp_cmd_tx() {
-    uint8_t const msp_cmd[5] = {
-        MSP_FC_VARIANT,
-        MSP_GET_VTX_CONFIG,
-        MSP_GET_OSD_CANVAS,
-        MSP_STATUS,
-        MSP_RC};
-
-    uint8_t idx, start = 0, end = 0;
-
-    // Process in strict order: VARIANT; VTX_CONFIG; then STATUS/RC/OSD_CANVAS
-    if (fc_lock & FC_VARIANT_LOCK) {
-        start = 1;
-        end = 1; // Config only
-        if (fc_lock & FC_VTX_CONFIG_LOCK) {
-            end = 4; // the rest...
-            if (msp_cmp_fc_variant("INAV")) {
-                start = 3; // OSD_CANVAS not reuired for iNav
-            }
+    uint8_t idx, interval;
+
+    if (msp_arm_fast_cnt)
+        msp_arm_fast_cnt--;
+
+    msp_req_timeout_check();
+
+    for (idx = 0; idx < MSP_POLL_NUM; idx++) {
+        interval = msp_poll_interval(idx);
+        if (interval == 0) {
+            msp_poll_cnt[idx] = 0;
+            continue;
         }
-    }
 
-    for (idx = start; idx <= end; idx++) {
+        if (msp_poll_cnt[idx] > interval)
+            msp_poll_cnt[idx] = interval;
+        if (msp_poll_cnt[idx])
+            msp_poll_cnt[idx]--;
+        if (msp_poll_cnt[idx])
+            continue;
+
+        // FC is still answering the last one, try again next tick
+        if (msp_req_busy(idx)) {
+            msp_poll_cnt[idx] = 1;
+            continue;
+        }
+        msp_poll_cnt[idx] = interval;
+
         msp_send_command(0, MSP_HEADER_V1);
-        msp_tx(0x00);         // len
-        msp_tx(msp_cmd[idx]); // function
-        msp_tx(msp_cmd[idx]); // crc
+        msp_tx(0x00);             // len
+        msp_tx(msp_req_cmd[idx]); // function
+        msp_tx(msp_req_cmd[idx]); // crc
+        msp_req_sent(idx);
+    }
+}
+
+uint8_t msp_req_busy(uint8_t idx) {
+    return msp_req[idx].pending && ((uint16_t)(timer_ms10x - msp_req[idx].sent) < MSP_REQ_TIMEOUT);
+}
+
+void msp_req_sent(uint8_t idx) {
+    msp_req[idx].sent = timer_ms10x;
+    msp_req[idx].pending = 1;
+}
+
+void msp_req_done(uint8_t cmd) {
+    uint8_t idx;
+    uint16_t rtt;
+    XDATA_SEG msp_req_t *req;
+
+    for (idx = 0; idx < MSP_REQ_NUM; idx++) {
+        if (msp_req_cmd[idx] == cmd)
+            break;
+    }
+    if (idx == MSP_REQ_NUM)
+        return;
+
+    req = &msp_req[idx];
+    if (!req->pending)
+        return;
+
+    rtt = timer_ms10x - req->sent;
+    req->pending = 0;
+    req->retry = 0;
+    req->rtt_last = rtt;
+    if (req->replies == 0) {
+        req->rtt_min = rtt;
+        req->rtt_max = rtt;
+        req->rtt_avg = rtt;
+    } else {
+        if (rtt < req->rtt_min)
+            req->rtt_min = rtt;
+        if (rtt > req->rtt_max)
+            req->rtt_max = rtt;
+        req->rtt_avg = req->rtt_avg - (req->rtt_avg >> 3) + (rtt >> 3);
+    }
+    if (req->replies != 0xffff)
+        req->replies++;
+}
+
+// Drop requests the FC did not answer in time and resend them up to MSP_REQ_RETRY times.
+void msp_req_timeout_check() {
+    uint8_t idx;
+    XDATA_SEG msp_req_t *req;
+
+    for (idx = 0; idx < MSP_REQ_NUM; idx++) {
+        req = &msp_req[idx];
+        if (!req->pending || ((uint16_t)(timer_ms10x - req->sent) < MSP_REQ_TIMEOUT))
+            continue;
+
+        req->pending = 0;
+        if (req->timeouts != 0xffff)
+            req->timeouts++;
+
+        if (req->retry >= MSP_REQ_RETRY) {
+            req->retry = 0;
+            continue;
+        }
+        req->retry++;
+
+        if (idx < MSP_POLL_NUM)
+            msp_poll_cnt[idx] = 1; // due on this tick
+        else if (vtx_cfg_resend)
+            msp_set_vtx_config(vtx_cfg_power, 0); // never repeat the FC eeprom write
     }
 }
 
 void msp_eeprom_write() {
     msp_send_command(1, MSP_HEADER_V1);
     msp_tx(0x00);
-    msp_tx(250);
-    msp_tx(250);
+    msp_tx(MSP_EEPROM_WRITE);
+    msp_tx(MSP_EEPROM_WRITE);
 }
 
 void msp_send_vtx_model_name() {
@@ -884,6 +1256,101 @@ void msp_send_vtx_hw_faults() {
     msp_tx(crc);
 }
 
+#ifdef USE_TELEMETRY
+// Wire format of one telem_ring entry, little endian
+static void telem_entry_pack(uint8_t idx, uint8_t *buf) {
+    buf[0] = telem_ring[idx].temp & 0xff;
+    buf[1] = telem_ring[idx].temp >> 8;
+    buf[2] = telem_ring[idx].pwr_offset;
+    buf[3] = telem_ring[idx].cur_pwr;
+    buf[4] = telem_ring[idx].rf_freq;
+    buf[5] = telem_ring[idx].dp_depth;
+    buf[6] = telem_ring[idx].uart_err;
+}
+
+#ifdef USE_TELEMETRY_VRX
+// {header0, header1, TELEM_HEADER, len, sec_l, sec_h, entry[TELEM_ENTRY_LEN]}
+static uint8_t get_tx_data_telem(uint8_t idx) {
+    tx_buf[0] = DP_HEADER0;
+    tx_buf[1] = DP_HEADER1;
+    tx_buf[2] = TELEM_HEADER;
+    tx_buf[3] = 2 + TELEM_ENTRY_LEN;
+    tx_buf[4] = telem_sec & 0xff;
+    tx_buf[5] = telem_sec >> 8;
+    telem_entry_pack(idx, &tx_buf[6]);
+    return 6 + TELEM_ENTRY_LEN + 1;
+}
+#endif
+
+// Sample the thermal and RF state into telem_ring once a second
+void telem_task() {
+    static uint16_t last_err = 0;
+    uint16_t err;
+    uint8_t idx;
+
+    if (telem_sec == seconds)
+        return;
+    telem_sec = seconds;
+
+    err = msp_rx_oversize;
+#ifdef USE_SMARTAUDIO_SW
+    err += suart_frame_err;
+#endif
+
+    idx = telem_head;
+    telem_ring[idx].temp = temperature;
+    telem_ring[idx].pwr_offset = pwr_offset;
+    telem_ring[idx].cur_pwr = cur_pwr;
+    telem_ring[idx].rf_freq = RF_FREQ;
+    telem_ring[idx].dp_depth = dptx_peak;
+    telem_ring[idx].uart_err = ((err - last_err) > 0x7f) ? 0x7f : (err - last_err);
+    if (RS0_ERR) {
+        RS0_ERR = 0;
+        telem_ring[idx].uart_err |= TELEM_UART_OVR;
+    }
+    last_err = err;
+    dptx_peak = 0;
+
+    telem_head = (idx + 1) & (TELEM_RING_SIZE - 1);
+    if (telem_count < TELEM_RING_SIZE)
+        telem_count++;
+
+#ifdef USE_TELEMETRY_VRX
+    insert_tx_buf(get_tx_data_telem(idx));
+#endif
+}
+
+// {count, sec_l, sec_h, entry[count]}, oldest entry first
+void msp_send_vtx_telemetry() {
+    uint8_t crc = 0;
+    uint8_t buf[TELEM_ENTRY_LEN];
+    uint8_t i, j, idx;
+
+    msp_send_response(0, MSP_HEADER_V2);
+    crc = msp_send_header_v2(3 + telem_count * TELEM_ENTRY_LEN, MSP_VTX_GET_TELEMETRY);
+
+    // Payload
+    buf[0] = telem_count;
+    buf[1] = telem_sec & 0xff;
+    buf[2] = telem_sec >> 8;
+    for (j = 0; j < 3; j++) {
+        msp_tx(buf[j]);
+        crc = crc8tab[crc ^ buf[j]];
+    }
+
+    idx = (telem_head - telem_count) & (TELEM_RING_SIZE - 1);
+    for (i = 0; i < telem_count; i++) {
+        telem_entry_pack(idx, buf);
+        for (j = 0; j < TELEM_ENTRY_LEN; j++) {
+            msp_tx(buf[j]);
+            crc = crc8tab[crc ^ buf[j]];
+        }
+        idx = (idx + 1) & (TELEM_RING_SIZE - 1);
+    }
+    msp_tx(crc);
+}
+#endif
+
 void msp_set_vtx_config(uint8_t power, uint8_t save) {
     uint8_t crc = 0;
     uint8_t channel = RF_FREQ;
@@ -959,15 +1426,24 @@ void msp_set_vtx_config(uint8_t power, uint8_t save) {
     crc ^= 0x00; // disable/clear vtx table
     msp_tx(crc);
 
+    vtx_cfg_power = power;
+    vtx_cfg_resend = 1;
+    msp_req_sent(MSP_REQ_SET_VTX_CONFIG);
+
     if (save)
         msp_eeprom_write();
 }
 
 void parse_status() {
 
+    uint8_t armed;
+
     fc_lock |= FC_STATUS_LOCK;
 
-    g_IS_ARMED = (msp_rx_buf[6] & 0x01);
+    armed = (msp_rx_buf[6] & 0x01);
+    if (armed != g_IS_ARMED)
+        msp_arm_fast_cnt = 16; // 2s
+    g_IS_ARMED = armed;
 #if (0)
     g_IS_PARALYZE = (msp_rx_buf[9] & 0x80);
 
@@ -1027,19 +1503,17 @@ void msp_set_osd_canvas(void) {
 }
 
 void msp_set_inav_osd_canvas(void) {
-    if (msp_cmp_fc_variant("INAV")) {
-        resolution = HD_5018;
-        osd_menu_offset = 8;
-    }
+    if (msp_cmp_fc_variant("INAV"))
+        osd_canvas_set(HD_5018);
 }
 
 void parse_get_osd_canvas(void) {
     if (msp_rx_buf[0] == OSD_CANVAS_HD_HMAX0 && msp_rx_buf[1] == OSD_CANVAS_HD_VMAX0) {
-        resolution = HD_5018;
-        osd_menu_offset = 8;
+        osd_canvas_set(HD_5018);
+        fc_lock |= FC_OSD_CANVAS_LOCK;
     } else if (msp_rx_buf[0] == OSD_CANVAS_SD_HMAX && msp_rx_buf[1] == OSD_CANVAS_SD_VMAX) {
-        resolution = SD_3016;
-        osd_menu_offset = 0;
+        osd_canvas_set(SD_3016);
+        fc_lock |= FC_OSD_CANVAS_LOCK;
     }
 }
 
@@ -1207,12 +1681,41 @@ void parseMspVtx_V2(void) {
     }
 }
 
+// Records of {row, col, attr, len, string[len]} following the sub command,
+// all applied to osd_buf from one MSP frame.
+void parse_displayport_write_many(uint16_t size) {
+    uint16_t ptr = 1;
+    uint8_t row, col, n;
+    uint8_t planes;
+    uint8_t is_btfl = msp_cmp_fc_variant("BTFL");
+
+    if (size > MSP_RX_BUF_SIZE)
+        size = MSP_RX_BUF_SIZE;
+
+    while (ptr + 4 <= size) {
+        row = msp_rx_buf[ptr];
+        col = msp_rx_buf[ptr + 1];
+        planes = osd_attr_decode(msp_rx_buf[ptr + 2], is_btfl);
+        n = msp_rx_buf[ptr + 3];
+        ptr += 4;
+        if (ptr + n > size) // truncated record
+            return;
+
+        if (resolution == HD_3016) {
+            row -= 1;
+            col -= 10;
+        }
+        mark_loc(row, col);
+        write_string(&msp_rx_buf[ptr], row, col, n, planes);
+        ptr += n;
+    }
+}
+
 uint8_t parse_displayport(uint8_t len) {
     uint8_t row = 0, col = 0;
     uint8_t state_osd = MSP_OSD_SUBCMD;
-    uint8_t ptr = 0;
     uint8_t i = 0;
-    uint8_t page_extend = 0;
+    uint8_t planes = 0;
 
     while (i != 64) {
         switch (state_osd) {
@@ -1222,14 +1725,32 @@ uint8_t parse_displayport(uint8_t len) {
             else if (msp_rx_buf[0] == SUBCMD_RELEASE)
                 return 0;
             else if (msp_rx_buf[0] == SUBCMD_CLEAR) {
+#ifdef USE_OSD_BACK_BUFFER
+                // front buffer stays on air until SUBCMD_DRAW
+                if (disp_mode == DISPLAY_OSD)
+                    osd_stage_clear();
+#else
                 if (disp_mode == DISPLAY_OSD)
                     clear_screen();
                 osd_ready = 0;
+#endif
                 return 0;
             } else if (msp_rx_buf[0] == SUBCMD_WRITE) {
+#ifndef USE_OSD_BACK_BUFFER
                 osd_ready = 0;
+#endif
                 state_osd = MSP_OSD_LOC;
+            } else if (msp_rx_buf[0] == SUBCMD_WRITE_MANY) {
+#ifndef USE_OSD_BACK_BUFFER
+                osd_ready = 0;
+#endif
+                parse_displayport_write_many((uint16_t)len + 4);
+                return 0;
             } else if (msp_rx_buf[0] == SUBCMD_DRAW) {
+#ifdef USE_OSD_BACK_BUFFER
+                if (disp_mode == DISPLAY_OSD)
+                    osd_commit();
+#endif
                 osd_ready = 1;
                 if (!(fc_lock & FC_OSD_LOCK)) {
                     Flicker_LED(3);
@@ -1238,12 +1759,7 @@ uint8_t parse_displayport(uint8_t len) {
                 return 1;
             } else if (msp_rx_buf[0] == SUBCMD_CONFIG) {
                 fontType = msp_rx_buf[1];
-                resolution = msp_rx_buf[2];
-
-                if (resolution == HD_5018)
-                    osd_menu_offset = 8;
-                else
-                    osd_menu_offset = 0;
+                osd_canvas_set(msp_rx_buf[2]);
 
                 if (resolution != resolution_last)
                     fc_init();
@@ -1267,17 +1783,12 @@ uint8_t parse_displayport(uint8_t len) {
             if (len == 0)
                 return 0;
             else {
-                if (msp_cmp_fc_variant("BTFL"))
-                    page_extend = 0;
-                else
-                    page_extend = msp_rx_buf[3] & 0x01;
+                planes = osd_attr_decode(msp_rx_buf[3], msp_cmp_fc_variant("BTFL"));
                 state_osd = MSP_OSD_WRITE;
             }
             break;
         case MSP_OSD_WRITE:
-            for (ptr = 0; ptr < len; ptr++) {
-                write_string(msp_rx_buf[4 + ptr], row, col + ptr, page_extend);
-            }
+            write_string(&msp_rx_buf[4], row, col, len, planes);
             return 0;
         default:
             break;
@@ -1287,6 +1798,75 @@ uint8_t parse_displayport(uint8_t len) {
     return 0;
 }
 
+// Stick commands, every matching row sets its bit in stick_cmd_match()
+CODE_SEG const stick_gesture_t stick_cmd_tab[] = {
+    {STK_MASK_ALL, STK_Y(STICK_LO) | STK_T(STICK_LO) | STK_P(STICK_LO) | STK_R(STICK_HI), 0, STICK_CMD_ENTER_0MW},
+    {STK_MASK_ALL, STK_Y(STICK_LO) | STK_T(STICK_HI) | STK_P(STICK_HI) | STK_R(STICK_HI), 1, STICK_CMD_ENTER_0MW},
+    {STK_MASK_ALL, STK_Y(STICK_HI) | STK_T(STICK_LO) | STK_P(STICK_LO) | STK_R(STICK_LO), 0, STICK_CMD_EXIT_0MW},
+    {STK_MASK_ALL, STK_Y(STICK_HI) | STK_T(STICK_HI) | STK_P(STICK_HI) | STK_R(STICK_LO), 1, STICK_CMD_EXIT_0MW},
+    {STK_MASK_ALL, STK_Y(STICK_HI) | STK_T(STICK_LO) | STK_P(STICK_LO) | STK_R(STICK_LO), 0xff, STICK_CMD_VTX_MENU},
+};
+// frames a command has to be held before it is reported
+CODE_SEG const uint8_t stick_cmd_hold[STICK_CMD_NUM] = {1, 1, 1};
+uint8_t stick_cmd_cnt[STICK_CMD_NUM];
+
+// Menu buttons, first matching row wins
+CODE_SEG const stick_gesture_t stick_btn_tab[] = {
+    {STK_MASK_NO_THR, STK_Y(STICK_MID) | STK_P(STICK_MID) | STK_R(STICK_MID), 0xff, BTN_MID},
+    {STK_MASK_ALL, STK_Y(STICK_HI) | STK_T(STICK_MID) | STK_P(STICK_MID) | STK_R(STICK_MID), 0xff, BTN_ENTER},
+    {STK_MASK_NO_THR, STK_Y(STICK_LO) | STK_P(STICK_MID) | STK_R(STICK_MID), 0xff, BTN_EXIT},
+    {STK_MASK_THR_NO_HI, STK_Y(STICK_MID) | STK_P(STICK_HI) | STK_R(STICK_MID), 0xff, BTN_UP},
+    {STK_MASK_THR_NO_HI, STK_Y(STICK_MID) | STK_P(STICK_LO) | STK_R(STICK_MID), 0xff, BTN_DOWN},
+    {STK_MASK_THR_NO_HI, STK_Y(STICK_MID) | STK_P(STICK_MID) | STK_R(STICK_LO), 0xff, BTN_LEFT},
+    {STK_MASK_THR_NO_HI, STK_Y(STICK_MID) | STK_P(STICK_MID) | STK_R(STICK_HI), 0xff, BTN_RIGHT},
+};
+
+uint8_t stick_axis(uint16_t x) {
+    if (IS_HI(x))
+        return STICK_HI;
+    if (IS_LO(x))
+        return STICK_LO;
+    return STICK_MID;
+}
+
+uint8_t stick_encode(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throttle) {
+    return STK_Y(stick_axis(yaw)) | STK_T(stick_axis(throttle)) | STK_P(stick_axis(pitch)) | STK_R(stick_axis(roll));
+}
+
+// bit per stick_cmd_e, set once the command has been held long enough
+uint8_t stick_cmd_match(uint8_t stick) {
+    uint8_t i, hit = 0, ret = 0;
+
+    for (i = 0; i < sizeof(stick_cmd_tab) / sizeof(stick_gesture_t); i++) {
+        if ((stick & stick_cmd_tab[i].mask) != stick_cmd_tab[i].value)
+            continue;
+        if (stick_cmd_tab[i].shortcut != 0xff && stick_cmd_tab[i].shortcut != SHORTCUT)
+            continue;
+        hit |= 1 << stick_cmd_tab[i].event;
+    }
+
+    for (i = 0; i < STICK_CMD_NUM; i++) {
+        if (hit & 1) {
+            if (stick_cmd_cnt[i] != 0xff)
+                stick_cmd_cnt[i]++;
+            if (stick_cmd_cnt[i] >= stick_cmd_hold[i])
+                ret |= 1 << i;
+        } else
+            stick_cmd_cnt[i] = 0;
+        hit >>= 1;
+    }
+    return ret;
+}
+
+uint8_t stick_btn_match(uint8_t stick) {
+    uint8_t i;
+    for (i = 0; i < sizeof(stick_btn_tab) / sizeof(stick_gesture_t); i++) {
+        if ((stick & stick_btn_tab[i].mask) == stick_btn_tab[i].value)
+            return stick_btn_tab[i].event;
+    }
+    return BTN_INVALID;
+}
+
 void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throttle) {
     /*
      *                throttle(油门) +                                          pitch(俯仰) +
@@ -1307,25 +1887,11 @@ void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throt
     uint8_t VirtualBtn = BTN_INVALID;
     static uint8_t VirtualBtn_last = BTN_INVALID;
 
-    uint8_t IS_HI_yaw = IS_HI(yaw);
-    uint8_t IS_LO_yaw = IS_LO(yaw);
-    uint8_t IS_MID_yaw = IS_MID(yaw);
-
-    uint8_t IS_HI_throttle = IS_HI(throttle);
-    uint8_t IS_LO_throttle = IS_LO(throttle);
-    uint8_t IS_MID_throttle = IS_MID(throttle);
-
-    uint8_t IS_HI_pitch = IS_HI(pitch);
-    uint8_t IS_LO_pitch = IS_LO(pitch);
-    uint8_t IS_MID_pitch = IS_MID(pitch);
-
-    uint8_t IS_HI_roll = IS_HI(roll);
-    uint8_t IS_LO_roll = IS_LO(roll);
-    uint8_t IS_MID_roll = IS_MID(roll);
-    uint8_t stick_cmd_enter_0mw = (IS_LO_yaw && IS_LO_throttle && IS_HI_roll && IS_LO_pitch && SHORTCUT == 0) ||
-                                  (IS_LO_yaw && IS_HI_throttle && IS_HI_roll && IS_HI_pitch && SHORTCUT == 1);
-    uint8_t stick_cmd_exit_0mw = (IS_HI_yaw && IS_LO_throttle && IS_LO_roll && IS_LO_pitch && SHORTCUT == 0) ||
-                                 (IS_HI_yaw && IS_HI_throttle && IS_LO_roll && IS_HI_pitch && SHORTCUT == 1);
+    uint8_t stick = stick_encode(roll, pitch, yaw, throttle);
+    uint8_t stick_cmd = stick_cmd_match(stick);
+    uint8_t stick_cmd_enter_0mw = stick_cmd & (1 << STICK_CMD_ENTER_0MW);
+    uint8_t stick_cmd_exit_0mw = stick_cmd & (1 << STICK_CMD_EXIT_0MW);
+    uint8_t stick_cmd_vtx_menu = stick_cmd & (1 << STICK_CMD_VTX_MENU);
 
     if (g_IS_ARMED && (cms_state != CMS_OSD)) {
         fc_init();
@@ -1333,26 +1899,8 @@ void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throt
     }
 
     // btn control
-    if (IS_MID_yaw && IS_MID_roll && IS_MID_pitch) {
-        mid = 1;
-        VirtualBtn = BTN_MID;
-    } else {
-        mid = 0;
-        if (IS_HI_yaw && IS_MID_roll && IS_MID_pitch && IS_MID_throttle)
-            VirtualBtn = BTN_ENTER;
-        else if (IS_LO_yaw && IS_MID_roll && IS_MID_pitch)
-            VirtualBtn = BTN_EXIT;
-        else if (IS_MID_yaw && IS_MID_roll && IS_HI_pitch && !IS_HI_throttle)
-            VirtualBtn = BTN_UP;
-        else if (IS_MID_yaw && IS_MID_roll && IS_LO_pitch && !IS_HI_throttle)
-            VirtualBtn = BTN_DOWN;
-        else if (IS_MID_yaw && IS_LO_roll && IS_MID_pitch && !IS_HI_throttle)
-            VirtualBtn = BTN_LEFT;
-        else if (IS_MID_yaw && IS_HI_roll && IS_MID_pitch && !IS_HI_throttle)
-            VirtualBtn = BTN_RIGHT;
-        else
-            VirtualBtn = BTN_INVALID;
-    }
+    VirtualBtn = stick_btn_match(stick);
+    mid = (VirtualBtn == BTN_MID);
 
     switch (cms_state) {
     case CMS_OSD:
@@ -1361,7 +1909,7 @@ void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throt
                 cms_state = CMS_EXIT_0MW;
                 cms_cnt = 0;
                 break;
-            } else if (IS_HI_yaw && IS_LO_throttle && IS_LO_roll && IS_LO_pitch) {
+            } else if (stick_cmd_vtx_menu) {
                 cms_state = CMS_ENTER_VTX_MENU;
                 vtx_menu_init();
                 vtx_menu_state = VTX_MENU_CHANNEL;
@@ -1431,7 +1979,7 @@ void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throt
                 DM6300_AUXADC_Calib();
             }
         }
-        if (!(IS_HI_yaw && IS_LO_throttle && IS_LO_roll && IS_LO_pitch))
+        if (!stick_cmd_vtx_menu)
             cms_state = CMS_OSD;
         break;
 
@@ -1776,34 +2324,34 @@ void vtx_menu_init() {
     disp_mode = DISPLAY_CMS;
     clear_screen();
 
-    strcpy(osd_buf[0] + osd_menu_offset + 2, "----VTX_MENU----");
-    strcpy(osd_buf[2] + osd_menu_offset + 2, ">CHANNEL");
-    strcpy(osd_buf[3] + osd_menu_offset + 2, " POWER");
-    strcpy(osd_buf[4] + osd_menu_offset + 2, " LP_MODE");
-    strcpy(osd_buf[5] + osd_menu_offset + 2, " PIT_MODE");
-    strcpy(osd_buf[6] + osd_menu_offset + 2, " OFFSET_25MW");
-    strcpy(osd_buf[7] + osd_menu_offset + 2, " TEAM_RACE");
-    strcpy(osd_buf[8] + osd_menu_offset + 2, " SHORTCUTS");
-    strcpy(osd_buf[9] + osd_menu_offset + 2, " EXIT  ");
-    strcpy(osd_buf[10] + osd_menu_offset + 2, " SAVE&EXIT");
-    strcpy(osd_buf[11] + osd_menu_offset + 2, "------INFO------");
-    strcpy(osd_buf[12] + osd_menu_offset + 2, " VTX");
-    strcpy(osd_buf[13] + osd_menu_offset + 2, " VER");
-    strcpy(osd_buf[14] + osd_menu_offset + 2, " LIFETIME");
+    menu_label(0, osd_menu_offset + 2, "----VTX_MENU----");
+    menu_label(2, osd_menu_offset + 2, ">CHANNEL");
+    menu_label(3, osd_menu_offset + 2, " POWER");
+    menu_label(4, osd_menu_offset + 2, " LP_MODE");
+    menu_label(5, osd_menu_offset + 2, " PIT_MODE");
+    menu_label(6, osd_menu_offset + 2, " OFFSET_25MW");
+    menu_label(7, osd_menu_offset + 2, " TEAM_RACE");
+    menu_label(8, osd_menu_offset + 2, " SHORTCUTS");
+    menu_label(9, osd_menu_offset + 2, " EXIT  ");
+    menu_label(10, osd_menu_offset + 2, " SAVE&EXIT");
+    menu_label(11, osd_menu_offset + 2, "------INFO------");
+    menu_label(12, osd_menu_offset + 2, " VTX");
+    menu_label(13, osd_menu_offset + 2, " VER");
+    menu_label(14, osd_menu_offset + 2, " LIFETIME");
 #ifdef USE_TEMPERATURE_SENSOR
-    strcpy(osd_buf[15] + osd_menu_offset + 2, " TEMPERATURE");
+    menu_label(15, osd_menu_offset + 2, " TEMPERATURE");
 #endif
 
     for (i = 2; i < 9; i++) {
-        osd_buf[i][osd_menu_offset + 19] = '<';
-        osd_buf[i][osd_menu_offset + 26] = '>';
+        menu_char(i, osd_menu_offset + 19, '<');
+        menu_char(i, osd_menu_offset + 26, '>');
     }
 
     // draw variant
-    strcpy(osd_buf[12] + osd_menu_offset + 13, VTX_NAME);
+    menu_label(12, osd_menu_offset + 13, VTX_NAME);
 
     // draw version
-    strcpy(osd_buf[13] + osd_menu_offset + 13, VTX_VERSION_STRING);
+    menu_label(13, osd_menu_offset + 13, VTX_VERSION_STRING);
 
     vtx_channel = RF_FREQ;
     vtx_power = RF_POWER;
@@ -1816,9 +2364,9 @@ void vtx_menu_init() {
 }
 
 void update_vtx_menu_param(uint8_t state) {
-    uint8_t i;
     uint8_t hourString[4];
     uint8_t minuteString[2];
+    char str[9];
     const char *powerString[] = {"   25", "  200", "  500", "  MAX"};
     const char *lowPowerString[] = {"  OFF", "   ON", "  1ST"};
     const char *pitString[] = {"  OFF", " P1MW", "  0MW"};
@@ -1826,66 +2374,68 @@ void update_vtx_menu_param(uint8_t state) {
     const char *shortcutString[] = {"OPT_A", "OPT_B"};
 
     // cursor
-    state += 2;
-    for (i = 2; i < 11; i++) {
-        if (i == state)
-            osd_buf[i][osd_menu_offset + 2] = '>';
-        else
-            osd_buf[i][osd_menu_offset + 2] = ' ';
-    }
+    menu_cursor(osd_menu_offset + 2, 2, 10, state + 2);
 
     // channel display
     if (vtx_channel < 8) {
-        osd_buf[2][osd_menu_offset + 23] = 'R';
-        osd_buf[2][osd_menu_offset + 24] = vtx_channel + '1';
+        str[0] = 'R';
+        str[1] = vtx_channel + '1';
     } else if (vtx_channel < 9) {
-        osd_buf[2][osd_menu_offset + 23] = 'E';
-        osd_buf[2][osd_menu_offset + 24] = '1';
+        str[0] = 'E';
+        str[1] = '1';
     } else if (vtx_channel < 12) {
-        osd_buf[2][osd_menu_offset + 23] = 'F';
+        str[0] = 'F';
         if (vtx_channel == 9)
-            osd_buf[2][osd_menu_offset + 24] = '1';
+            str[1] = '1';
         else if (vtx_channel == 10)
-            osd_buf[2][osd_menu_offset + 24] = '2';
-        else if (vtx_channel == 11)
-            osd_buf[2][osd_menu_offset + 24] = '4';
+            str[1] = '2';
+        else
+            str[1] = '4';
     } else {
-        osd_buf[2][osd_menu_offset + 23] = 'L';
-        osd_buf[2][osd_menu_offset + 24] = '1' + vtx_channel - 12;
+        str[0] = 'L';
+        str[1] = '1' + vtx_channel - 12;
     }
+    str[2] = 0;
+    menu_label(2, osd_menu_offset + 23, str);
 
-    strcpy(osd_buf[3] + osd_menu_offset + 20, powerString[vtx_power]);
-    strcpy(osd_buf[4] + osd_menu_offset + 20, lowPowerString[vtx_lp]);
-    strcpy(osd_buf[5] + osd_menu_offset + 20, pitString[vtx_pit]);
+    menu_label(3, osd_menu_offset + 20, powerString[vtx_power]);
+    menu_label(4, osd_menu_offset + 20, lowPowerString[vtx_lp]);
+    menu_label(5, osd_menu_offset + 20, pitString[vtx_pit]);
 
     if (vtx_offset < 10) {
-        strcpy(osd_buf[6] + osd_menu_offset + 20, "     ");
-        osd_buf[6][osd_menu_offset + 23] = '0' + vtx_offset;
+        strcpy(str, "   0 ");
+        str[3] = '0' + vtx_offset;
+        menu_label(6, osd_menu_offset + 20, str);
     } else if (vtx_offset == 10)
-        strcpy(osd_buf[6] + osd_menu_offset + 20, "   10");
+        menu_label(6, osd_menu_offset + 20, "   10");
     else if (vtx_offset < 20) {
-        strcpy(osd_buf[6] + osd_menu_offset + 20, "   -");
-        osd_buf[6][osd_menu_offset + 24] = '0' + (vtx_offset - 10);
+        strcpy(str, "   -0");
+        str[4] = '0' + (vtx_offset - 10);
+        menu_label(6, osd_menu_offset + 20, str);
     } else if (vtx_offset == 20)
-        strcpy(osd_buf[6] + osd_menu_offset + 20, "  -10");
+        menu_label(6, osd_menu_offset + 20, "  -10");
 
-    strcpy(osd_buf[7] + osd_menu_offset + 20, treamRaceString[vtx_team_race]);
+    menu_label(7, osd_menu_offset + 20, treamRaceString[vtx_team_race]);
 
-    strcpy(osd_buf[8] + osd_menu_offset + 20, shortcutString[vtx_shortcut]);
+    menu_label(8, osd_menu_offset + 20, shortcutString[vtx_shortcut]);
 
     ParseLifeTime(hourString, minuteString);
-    osd_buf[14][osd_menu_offset + 16] = hourString[0];
-    osd_buf[14][osd_menu_offset + 17] = hourString[1];
-    osd_buf[14][osd_menu_offset + 18] = hourString[2];
-    osd_buf[14][osd_menu_offset + 19] = hourString[3];
-    osd_buf[14][osd_menu_offset + 20] = 'H';
-    osd_buf[14][osd_menu_offset + 21] = minuteString[0];
-    osd_buf[14][osd_menu_offset + 22] = minuteString[1];
-    osd_buf[14][osd_menu_offset + 23] = 'M';
+    str[0] = hourString[0];
+    str[1] = hourString[1];
+    str[2] = hourString[2];
+    str[3] = hourString[3];
+    str[4] = 'H';
+    str[5] = minuteString[0];
+    str[6] = minuteString[1];
+    str[7] = 'M';
+    str[8] = 0;
+    menu_label(14, osd_menu_offset + 16, str);
 #ifdef USE_TEMPERATURE_SENSOR
-    osd_buf[15][osd_menu_offset + 16] = (temperature >> 2) / 100 + '0';
-    osd_buf[15][osd_menu_offset + 17] = ((temperature >> 2) % 100) / 10 + '0';
-    osd_buf[15][osd_menu_offset + 18] = ((temperature >> 2) % 10) + '0';
+    str[0] = (temperature >> 2) / 100 + '0';
+    str[1] = ((temperature >> 2) % 100) / 10 + '0';
+    str[2] = ((temperature >> 2) % 10) + '0';
+    str[3] = 0;
+    menu_label(15, osd_menu_offset + 16, str);
 #endif
 }
 
@@ -2083,73 +2633,111 @@ CODE_SEG const uint8_t bf_vtx_power_table[5][9] = {
 CODE_SEG const uint8_t bf_vtx_power_500mW[9] = {0x07, 0xe4, 0x03, 0x1b, 0x00, 0x03, '5', '0', '0'}; // 500mW
 CODE_SEG const uint8_t bf_vtx_power_1W[9] = {0x07, 0xe4, 0x04, 0x1e, 0x00, 0x03, 'M', 'A', 'X'};    // MAX
 
-void InitVtxTable() {
-    uint8_t i, j;
-    uint8_t crc;
-    uint8_t const *power_table[5];
-
-    // set band num, channel num and power level number
-    if (TEAM_RACE)
-        msp_set_vtx_config(POWER_MAX + 1, 0);
-    else
-        msp_set_vtx_config(RF_POWER, 0);
-
-    // set band/channel
-    for (i = 0; i < 5; i++) {
-        msp_send_command(1, MSP_HEADER_V1);
-        crc = 0;
-        for (j = 0; j < 31; j++) {
-            msp_tx(bf_vtx_band_table[i][j]);
-            crc ^= bf_vtx_band_table[i][j];
-        }
-        msp_tx(crc);
+CODE_SEG const uint8_t bf_vtx_eeprom_write[2] = {0x00, MSP_EEPROM_WRITE};
+
+// Upload sequence: vtx config, 5 bands, low band, 5 power levels, eeprom write.
+// One frame is sent per 16Hz slot and the next one only after the FC replied.
+#define VTX_TABLE_STEP_CONFIG  0
+#define VTX_TABLE_STEP_BAND    1
+#define VTX_TABLE_STEP_LOWBAND 6
+#define VTX_TABLE_STEP_POWER   7
+#define VTX_TABLE_STEP_EEPROM  12
+#define VTX_TABLE_STEP_NUM     13
+#define VTX_TABLE_TIMEOUT      4 // 1/16s ticks
+#define VTX_TABLE_RETRY        3
+
+uint8_t vtx_table_step = VTX_TABLE_STEP_NUM;
+uint8_t vtx_table_cmd = 0; // function code expected in the FC reply
+uint8_t vtx_table_wait = 0;
+uint8_t vtx_table_tick = 0;
+uint8_t vtx_table_retry = 0;
+
+uint8_t const *vtx_table_power_entry(uint8_t i) {
+#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
+    // if we dont have power lock, enable 500mw and 1W
+    if (!powerLock) {
+        if (i == 2)
+            return bf_vtx_power_500mW;
+        if (i == 3)
+            return bf_vtx_power_1W;
     }
+#endif
+    return bf_vtx_power_table[i];
+}
 
-    // set low band
-    i = lowband_lock ? 6 : 5;
-    msp_send_command(1, MSP_HEADER_V1);
-    crc = 0;
-    for (j = 0; j < 31; j++) {
-        msp_tx(bf_vtx_band_table[i][j]);
-        crc ^= bf_vtx_band_table[i][j];
+void vtx_table_send(uint8_t const *frame, uint8_t len) {
+    uint8_t j;
+    uint8_t crc = 0;
+
+    msp_send_command(0, MSP_HEADER_V1);
+    for (j = 0; j < len; j++) {
+        msp_tx(frame[j]);
+        crc ^= frame[j];
     }
     msp_tx(crc);
+    vtx_table_cmd = frame[1];
+}
 
-    // first two entries are always the same
-    power_table[0] = bf_vtx_power_table[0];
-    power_table[1] = bf_vtx_power_table[1];
-
-#if defined HDZERO_FREESTYLE_V1 || HDZERO_FREESTYLE_V2
-    if (!powerLock) {
-        // if we dont have power lock, enable 500mw and 1W
-        power_table[2] = bf_vtx_power_500mW;
-        power_table[3] = bf_vtx_power_1W;
+void vtx_table_send_step(uint8_t step) {
+    if (step == VTX_TABLE_STEP_CONFIG) {
+        // set band num, channel num and power level number
+        if (TEAM_RACE)
+            msp_set_vtx_config(POWER_MAX + 1, 0);
+        else
+            msp_set_vtx_config(RF_POWER, 0);
+        vtx_cfg_resend = 0;
+        vtx_table_cmd = MSP_SET_VTX_CONFIG;
+    } else if (step < VTX_TABLE_STEP_LOWBAND) {
+        vtx_table_send(bf_vtx_band_table[step - VTX_TABLE_STEP_BAND], 31);
+    } else if (step == VTX_TABLE_STEP_LOWBAND) {
+        vtx_table_send(bf_vtx_band_table[lowband_lock ? 6 : 5], 31);
+    } else if (step < VTX_TABLE_STEP_EEPROM) {
+        vtx_table_send(vtx_table_power_entry(step - VTX_TABLE_STEP_POWER), 9);
     } else {
-        // otherwise add empties
-        power_table[2] = bf_vtx_power_table[2];
-        power_table[3] = bf_vtx_power_table[3];
+        vtx_table_send(bf_vtx_eeprom_write, 2);
     }
-#else
-    power_table[2] = bf_vtx_power_table[2];
-    power_table[3] = bf_vtx_power_table[3];
-#endif
+}
 
-    // last entry is alway the same
-    power_table[4] = bf_vtx_power_table[4];
+void vtx_table_next_step() {
+    vtx_table_wait = 0;
+    vtx_table_retry = 0;
+    vtx_table_step++;
+    if (vtx_table_step == VTX_TABLE_STEP_NUM)
+        init_table_done = 1;
+}
 
-    // send all of them
-    for (i = 0; i < 5; i++) {
-        msp_send_command(1, MSP_HEADER_V1);
-        crc = 0;
-        for (j = 0; j < 9; j++) {
-            msp_tx(power_table[i][j]);
-            crc ^= power_table[i][j];
+void InitVtxTable() {
+    vtx_table_step = VTX_TABLE_STEP_CONFIG;
+    vtx_table_wait = 0;
+    vtx_table_retry = 0;
+    init_table_done = 0;
+}
+
+void vtx_table_task() {
+    if (vtx_table_step >= VTX_TABLE_STEP_NUM || !timer_16hz)
+        return;
+
+    if (vtx_table_wait) {
+        vtx_table_tick++;
+        if (vtx_table_tick < VTX_TABLE_TIMEOUT)
+            return;
+        vtx_table_retry++;
+        if (vtx_table_retry > VTX_TABLE_RETRY) {
+            // FC never confirmed, keep going like the old blocking upload did
+            vtx_table_next_step();
+            if (vtx_table_step == VTX_TABLE_STEP_NUM)
+                return;
         }
-        msp_tx(crc);
     }
 
-    msp_eeprom_write();
-    init_table_done = 1;
+    vtx_table_send_step(vtx_table_step);
+    vtx_table_wait = 1;
+    vtx_table_tick = 0;
+}
+
+void vtx_table_ack(uint8_t cmd) {
+    if (vtx_table_wait && (cmd == vtx_table_cmd))
+        vtx_table_next_step();
 }
 #endif
 
@@ -8,8 +8,26 @@
 #define IS_LO(x)  ((x) < 1250)
 #define IS_MID(x) ((!IS_HI(x)) && (!IS_LO(x)))
 
+// stick state, 2 bits per axis: roll[7:6] pitch[5:4] throttle[3:2] yaw[1:0]
+#define STICK_MID 0
+#define STICK_LO  1
+#define STICK_HI  2
+
+#define STK_Y(x) ((x) << 0)
+#define STK_T(x) ((x) << 2)
+#define STK_P(x) ((x) << 4)
+#define STK_R(x) ((x) << 6)
+
+#define STK_MASK_ALL       0xff
+#define STK_MASK_NO_THR    0xf3 // throttle ignored
+#define STK_MASK_THR_NO_HI 0xfb // throttle only has to be not high
+
 #define TXBUF_SIZE 74
 
+// Large enough for any MSP v1 payload (length is 8 bit). MSP v2 frames with a
+// longer payload are dropped. The write pointer is 8 bit, so keep it <= 256.
+#define MSP_RX_BUF_SIZE 256
+
 typedef enum {
     BTN_UP,
     BTN_DOWN,
@@ -21,6 +39,20 @@ typedef enum {
     BTN_INVALID
 } ButtonEvent_e;
 
+typedef enum {
+    STICK_CMD_ENTER_0MW,
+    STICK_CMD_EXIT_0MW,
+    STICK_CMD_VTX_MENU,
+    STICK_CMD_NUM
+} stick_cmd_e;
+
+typedef struct {
+    uint8_t mask;
+    uint8_t value;
+    uint8_t shortcut; // SHORTCUT option it applies to, 0xff for any
+    uint8_t event;    // stick_cmd_e or ButtonEvent_e
+} stick_gesture_t;
+
 typedef enum {
     BTFL,
     INAV,
@@ -72,6 +104,33 @@ typedef enum {
     CUR_OTHERS
 } cur_cmd_e;
 
+// requests tracked while in flight, the polled ones come first
+typedef enum {
+    MSP_REQ_FC_VARIANT,
+    MSP_REQ_VTX_CONFIG,
+    MSP_REQ_OSD_CANVAS,
+    MSP_REQ_STATUS,
+    MSP_REQ_RC,
+    MSP_REQ_SET_VTX_CONFIG,
+    MSP_REQ_NUM
+} msp_req_e;
+
+#define MSP_POLL_NUM    MSP_REQ_SET_VTX_CONFIG
+#define MSP_REQ_TIMEOUT (TIMER0_1S >> 2) // 250ms
+#define MSP_REQ_RETRY   2
+
+typedef struct {
+    uint8_t pending;   // request sent, no reply yet
+    uint8_t retry;     // resends of the current request
+    uint16_t sent;     // timer_ms10x when the request was sent
+    uint16_t rtt_last; // round trip times, in timer_ms10x ticks
+    uint16_t rtt_min;
+    uint16_t rtt_max;
+    uint16_t rtt_avg; // IIR, 1/8 weight
+    uint16_t replies;
+    uint16_t timeouts;
+} msp_req_t;
+
 typedef enum {
     SUBCMD_HEARTBEAT,
     SUBCMD_RELEASE,
@@ -79,8 +138,22 @@ typedef enum {
     SUBCMD_WRITE,
     SUBCMD_DRAW,
     SUBCMD_CONFIG,
+    SUBCMD_WRITE_MANY = 0x40, // HDZero extension, several strings in one frame
 } displayport_subcmd_e;
 
+// DisplayPort attribute byte
+#define DP_ATTR_PAGE  0x01
+#define DP_ATTR_BLINK 0x40
+
+typedef enum {
+    OSD_PLANE_PAGE,  // second font page, sent to the VRX
+    OSD_PLANE_BLINK, // blanked locally at 1Hz
+    OSD_PLANE_NUM,
+} osd_plane_e;
+
+#define OSD_ATTR_PAGE  (1 << OSD_PLANE_PAGE)
+#define OSD_ATTR_BLINK (1 << OSD_PLANE_BLINK)
+
 typedef enum {
     SD_3016,
     HD_5018,
@@ -127,6 +200,22 @@ typedef enum {
     DISPLAY_CMS,
 } disp_mode_e;
 
+#ifdef USE_TELEMETRY
+#define TELEM_RING_SIZE 16   // 1Hz samples, power of 2
+#define TELEM_ENTRY_LEN 7    // bytes per sample on the wire
+#define TELEM_HEADER    0xfe // row_number of the VRX telemetry packet
+#define TELEM_UART_OVR  0x80 // uart_err: UART0 RX overrun
+
+typedef struct {
+    int16_t temp; // temperature, filtered x4
+    uint8_t pwr_offset;
+    uint8_t cur_pwr;
+    uint8_t rf_freq;
+    uint8_t dp_depth; // deepest dptxbuf fill since the last sample
+    uint8_t uart_err; // TELEM_UART_OVR | dropped MSP/SA frames (saturating)
+} telem_entry_t;
+#endif
+
 void msp_task();
 uint8_t msp_read_one_frame();
 void clear_screen();
@@ -134,17 +223,32 @@ void mark_flag(uint8_t row, uint8_t col);
 void init_txbuf();
 void fc_init();
 void mark_loc(uint8_t row, uint8_t col);
+uint8_t osd_attr_decode(uint8_t attr, uint8_t is_btfl);
+void osd_attr_span(uint8_t row, uint8_t col, uint8_t n, uint8_t planes);
+void write_string(uint8_t *str, uint8_t row, uint8_t col, uint8_t n, uint8_t planes);
+void menu_char(uint8_t row, uint8_t col, uint8_t c);
+void menu_label(uint8_t row, uint8_t col, const char *str);
+void menu_value(uint8_t row, uint8_t col, uint8_t width, const char *str);
+void menu_cursor(uint8_t col, uint8_t first, uint8_t last, uint8_t sel);
 uint8_t prepare_tx_buf();
 uint8_t get_tx_data_5680();
 uint8_t get_tx_data_osd(uint8_t index);
 void insert_tx_buf(uint8_t len);
 void DP_tx_task();
 void msp_cmd_tx();
+uint8_t msp_req_busy(uint8_t idx);
+void msp_req_sent(uint8_t idx);
+void msp_req_done(uint8_t cmd);
+void msp_req_timeout_check();
 void msp_send_vtx_model_name();
 void msp_send_vtx_fc_variant();
 void msp_send_vtx_fw_version();
 void msp_send_vtx_temperature();
 void msp_send_vtx_hw_faults();
+#ifdef USE_TELEMETRY
+void telem_task();
+void msp_send_vtx_telemetry();
+#endif
 void parse_status();
 void parse_rc();
 void parse_variant();
@@ -152,6 +256,16 @@ void parse_vtx_params(uint8_t isMSP_V2);
 void parse_vtx_config();
 void parseMspVtx_V2();
 uint8_t parse_displayport(uint8_t len);
+void osd_canvas_set(uint8_t res);
+#ifdef USE_OSD_BACK_BUFFER
+void osd_stage_clear();
+void osd_commit();
+#endif
+uint8_t osd_next_row(uint8_t t1);
+void parse_displayport_write_many(uint16_t size);
+uint8_t stick_encode(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throttle);
+uint8_t stick_cmd_match(uint8_t stick);
+uint8_t stick_btn_match(uint8_t stick);
 void update_cms_menu(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t throttle);
 void vtx_menu_init();
 void update_vtx_menu_param(uint8_t state);
@@ -162,11 +276,16 @@ uint8_t channel_to_bfChannel(uint8_t const channel);
 uint8_t bfChannel_to_channel(uint8_t const channel);
 #ifdef INIT_VTX_TABLE
 void InitVtxTable();
+void vtx_table_task();
+void vtx_table_ack(uint8_t cmd);
 #endif
+extern XDATA_SEG uint8_t msp_rx_buf[MSP_RX_BUF_SIZE];
+extern uint16_t msp_rx_oversize;
 extern uint8_t osd_buf[OSD_CANVAS_HD_VMAX1][OSD_CANVAS_HD_HMAX1];
 extern uint8_t osd_menu_offset;
 extern uint8_t disp_mode;
 extern uint8_t msp_tx_cnt;
+extern XDATA_SEG msp_req_t msp_req[MSP_REQ_NUM];
 extern uint8_t resolution;
 extern uint8_t first_arm;
 extern uint8_t mspVtxLock;
@@ -175,4 +294,5 @@ extern uint32_t fc_lst_rcv_sec;
 extern uint8_t g_IS_ARMED;
 extern uint8_t g_IS_PARALYZE;
 extern uint8_t msp_tx_en;
+extern uint8_t crc8tab[256];
 #endif /* __MSP_DISPLAYPORT_H_ */
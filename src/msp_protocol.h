@@ -13,14 +13,17 @@
 /**
  *  MSP v1 Protocol Types
  */
-#define MSP_FC_VARIANT     0x02 // 2   //out message
-#define MSP_GET_VTX_CONFIG 0x58 // 88  //out message
-#define MSP_SET_VTX_CONFIG 0x59 // 89  // in message
-#define MSP_STATUS         0x65 // 101 //out message
-#define MSP_RC             0x69 // 105 //out message
-#define MSP_DISPLAYPORT    0xB6 // 182 // in message
-#define MSP_SET_OSD_CANVAS 0xBC // 188 // in message
-#define MSP_GET_OSD_CANVAS 0xBD // 188 //out message
+#define MSP_FC_VARIANT              0x02 // 2   //out message
+#define MSP_GET_VTX_CONFIG          0x58 // 88  //out message
+#define MSP_SET_VTX_CONFIG          0x59 // 89  // in message
+#define MSP_STATUS                  0x65 // 101 //out message
+#define MSP_RC                      0x69 // 105 //out message
+#define MSP_DISPLAYPORT             0xB6 // 182 // in message
+#define MSP_SET_OSD_CANVAS          0xBC // 188 // in message
+#define MSP_GET_OSD_CANVAS          0xBD // 188 //out message
+#define MSP_SET_VTXTABLE_BAND       0xE3 // 227 // in message
+#define MSP_SET_VTXTABLE_POWERLEVEL 0xE4 // 228 // in message
+#define MSP_EEPROM_WRITE            0xFA // 250 // in message
 
 #define DP_HEADER0 0x56
 #define DP_HEADER1 0x80
@@ -30,6 +33,7 @@
 #define FC_RC_LOCK             0x04
 #define FC_VTX_CONFIG_LOCK     0x08
 #define FC_STATUS_LOCK         0x10
+#define FC_OSD_CANVAS_LOCK     0x20
 #define FC_INIT_VTX_TABLE_LOCK 0x80
 
 #define OSD_CANVAS_SD_HMAX  30
@@ -70,5 +74,6 @@
 #define MSP_VTX_GET_FW_VERSION  0x0386 // Query VTX for firmware version
 #define MSP_VTX_GET_TEMPERATURE 0x0387 // Query VTX for temperature in celcius
 #define MSP_VTX_GET_HW_FAULTS   0x0388 // Query VTX for hardware errors
+#define MSP_VTX_GET_TELEMETRY   0x0389 // Query VTX for the telemetry ring
 
 #endif /* __MSP_PROTO_H_ */
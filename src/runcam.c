@@ -133,48 +133,93 @@ const uint8_t runcam_micro_v3_attribute[CAMERA_SETTING_NUM][4] = {
     {0, 0x00, 0x00, 0x00},
 };
 
-void runcam_type_detect(void) {
-    uint8_t i, j;
+CODE_SEG const uint32_t runcam_micro_v2_vdo_fmt[4] = {0x0008910B, 0x00089102, 0x00089110, 0x81089106};
+CODE_SEG const uint32_t runcam_micro_v3_vdo_fmt[4] = {0x8208910B, 0x82089102, 0x82089110, 0x81089106};
+CODE_SEG const uint32_t runcam_nano_90_vdo_fmt[4] = {0x8008811d, 0x83088120, 0x8108811e, 0x8208811f};
+
+CODE_SEG const uint32_t runcam_night_off[3] = {0x30002900, 0x32003100, 0x34003300};
+CODE_SEG const uint32_t runcam_micro_v3_night_off[3] = {0x30003000, 0x32003200, 0x34003400};
+
+// Probe order of runcam_type_detect()
+const runcam_model_t runcam_model_tab[] = {
+    {CAMERA_TYPE_RUNCAM_MICRO_V1, RUNCAM_MICRO_V1, runcam_micro_v1_attribute,
+     0x0452004e, 0, 0,
+     0, 0},
+    {CAMERA_TYPE_RUNCAM_MICRO_V2, RUNCAM_MICRO_V2, runcam_micro_v2_attribute,
+     0x04500050, 0x460, RUNCAM_CAP_HV_FLIP | RUNCAM_CAP_NIGHT | RUNCAM_CAP_FMT_1080,
+     runcam_micro_v2_vdo_fmt, runcam_night_off},
+    {CAMERA_TYPE_RUNCAM_NANO_90, RUNCAM_NANO_90, runcam_nano_90_attribute,
+     0x04480048, 0x447, RUNCAM_CAP_HV_FLIP | RUNCAM_CAP_NIGHT | RUNCAM_CAP_SHUTTER_FIX,
+     runcam_nano_90_vdo_fmt, runcam_night_off},
+    {CAMERA_TYPE_RUNCAM_MICRO_V3, RUNCAM_MICRO_V3, runcam_micro_v3_attribute,
+     0x04500050, 0x460, RUNCAM_CAP_HV_FLIP | RUNCAM_CAP_NIGHT | RUNCAM_CAP_FMT_1080,
+     runcam_micro_v3_vdo_fmt, runcam_micro_v3_night_off},
+};
+
+// Settings that share a register are applied by the first one of the group
+CODE_SEG const uint8_t runcam_setting_group[CAMERA_SETTING_NUM] = {
+    CAM_SETTING_BRIGHTNESS, // 0x50
+    CAM_SETTING_SHARPNESS,
+    CAM_SETTING_CONTRAST,
+    CAM_SETTING_SATURATION,
+    CAM_SETTING_SHUTTER,
+    CAM_SETTING_WBMODE, // 0x1b8/0x204/0x208
+    CAM_SETTING_WBMODE,
+    CAM_SETTING_WBMODE,
+    CAM_SETTING_HVFLIP,
+    CAM_SETTING_NIGHT_MODE,
+    CAM_SETTING_BRIGHTNESS, // 0x50
+    CAM_SETTING_VDO_FMT,
+
+    0xff,
+    0xff,
+    0xff,
+    0xff,
+};
+
+const runcam_model_t *runcam_model = &runcam_model_tab[0];
+
+static uint8_t runcam_probe(uint8_t idx) {
     uint32_t rdat;
 
-    if (!RUNCAM_Write(RUNCAM_MICRO_V1, 0x50, 0x0452484E)) {
-        camera_type = CAMERA_TYPE_RUNCAM_MICRO_V1;
-        camera_device = RUNCAM_MICRO_V1;
-        for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-            for (j = 0; j < 4; j++)
-                camera_attribute[i][j] = runcam_micro_v1_attribute[i][j];
-        }
-    } else {
-        rdat = RUNCAM_Read(RUNCAM_MICRO_V2, 0x50);
-        if (rdat != 0x00000000 && rdat != 0xffffffff) {
-            camera_type = CAMERA_TYPE_RUNCAM_MICRO_V2;
-            camera_device = RUNCAM_MICRO_V2;
-            for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-                for (j = 0; j < 4; j++)
-                    camera_attribute[i][j] = runcam_micro_v2_attribute[i][j];
-            }
-            return;
-        }
+    if (runcam_model_tab[idx].device == RUNCAM_MICRO_V1)
+        return !RUNCAM_Write(RUNCAM_MICRO_V1, 0x50, 0x0452484E);
+
+    rdat = RUNCAM_Read(runcam_model_tab[idx].device, 0x50);
+    return (rdat != 0x00000000 && rdat != 0xffffffff);
+}
+
+static void runcam_model_set(uint8_t idx) {
+    uint8_t i, j;
+
+    runcam_model = &runcam_model_tab[idx];
+    camera_type = runcam_model->type;
+    camera_device = runcam_model->device;
+    for (i = 0; i < CAMERA_SETTING_NUM; i++) {
+        for (j = 0; j < 4; j++)
+            camera_attribute[i][j] = runcam_model->attribute[i][j];
+    }
+}
 
-        rdat = RUNCAM_Read(RUNCAM_NANO_90, 0x50);
-        if (rdat != 0x00000000 && rdat != 0xffffffff) {
-            camera_type = CAMERA_TYPE_RUNCAM_NANO_90;
-            camera_device = RUNCAM_NANO_90;
-            for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-                for (j = 0; j < 4; j++)
-                    camera_attribute[i][j] = runcam_nano_90_attribute[i][j];
+// type_last is the camera_type saved in EEPROM. It is verified with a single
+// probe and the other models are only probed when it does not answer.
+void runcam_type_detect(uint8_t type_last) {
+    uint8_t i;
+
+    for (i = 0; i < ARRAY_SIZE(runcam_model_tab); i++) {
+        if (runcam_model_tab[i].type == type_last) {
+            if (runcam_probe(i)) {
+                runcam_model_set(i);
+                return;
             }
-            return;
+            break;
         }
+    }
 
-        rdat = RUNCAM_Read(RUNCAM_MICRO_V3, 0x50);
-        if (rdat != 0x00000000 && rdat != 0xffffffff) {
-            camera_type = CAMERA_TYPE_RUNCAM_MICRO_V3;
-            camera_device = RUNCAM_MICRO_V3;
-            for (i = 0; i < CAMERA_SETTING_NUM; i++) {
-                for (j = 0; j < 4; j++)
-                    camera_attribute[i][j] = runcam_micro_v3_attribute[i][j];
-            }
+    for (i = 0; i < ARRAY_SIZE(runcam_model_tab); i++) {
+        if (runcam_model_tab[i].type != type_last && runcam_probe(i)) {
+            runcam_model_set(i);
+            return;
         }
     }
 }
@@ -202,17 +247,7 @@ void runcam_brightness(uint8_t val, uint8_t led_mode) {
     uint32_t d;
     uint32_t val_32;
 
-    camera_setting_reg_set[0] = val;
-    camera_setting_reg_set[10] = led_mode;
-
-    if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1)
-        d = 0x0452004e;
-    else if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2)
-        d = 0x04500050;
-    else if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3)
-        d = 0x04500050;
-    else // if (camera_type == CAMERA_TYPE_RUNCAM_NANO_90)
-        d = 0x04480048;
+    d = runcam_model->brightness;
 
     if (led_mode)
         d |= 0x00002800;
@@ -233,16 +268,8 @@ void runcam_brightness(uint8_t val, uint8_t led_mode) {
 }
 
 void runcam_sharpness(uint8_t val) {
-    uint32_t d;
-
-    camera_setting_reg_set[1] = val;
-
     if (val == 0) {
-        if (camera_type == RUNCAM_MICRO_V1)
-            d = 0x03FF0100;
-        else // if (camera_type == RUNCAM_MICRO_V2 || camera_type == RUNCAM_NANO_90)
-            d = 0x03FF0000;
-        RUNCAM_Read_Write(camera_device, 0x0003C4, d);
+        RUNCAM_Read_Write(camera_device, 0x0003C4, 0x03FF0000);
         RUNCAM_Read_Write(camera_device, 0x0003CC, 0x0A0C0E10);
         RUNCAM_Read_Write(camera_device, 0x0003D8, 0x0A0C0E10);
     } else if (val == 1) {
@@ -257,14 +284,7 @@ void runcam_sharpness(uint8_t val) {
 }
 
 void runcam_contrast(uint8_t val) {
-    uint32_t d;
-
-    camera_setting_reg_set[2] = val;
-
-    if (camera_type == RUNCAM_MICRO_V1)
-        d = 0x46484A4C;
-    else // if (camera_type == RUNCAM_MICRO_V2 || camera_type == RUNCAM_NANO_90)
-        d = 0x36383a3c;
+    uint32_t d = 0x36383a3c;
 
     if (val == 0) // low
         d -= 0x06040404;
@@ -277,16 +297,7 @@ void runcam_contrast(uint8_t val) {
 }
 
 void runcam_saturation(uint8_t val) {
-    uint8_t ret = 1;
-    uint32_t d;
-
-    camera_setting_reg_set[3] = val;
-
-    // initial
-    if (camera_type == RUNCAM_MICRO_V1)
-        d = 0x20242626;
-    else // if (camera_type == RUNCAM_MICRO_V2 || camera_type == RUNCAM_NANO_90)
-        d = 0x24282c30;
+    uint32_t d = 0x24282c30;
 
     if (val == 0)
         d = 0x00000000;
@@ -310,10 +321,6 @@ void runcam_wb(uint8_t wbMode, uint8_t wbRed, uint8_t wbBlue) {
     uint32_t wbRed_u32 = 0x02000000;
     uint32_t wbBlue_u32 = 0x00000000;
 
-    camera_setting_reg_set[5] = wbMode;
-    camera_setting_reg_set[6] = wbRed;
-    camera_setting_reg_set[7] = wbBlue;
-
     if (wbMode) {
         wbRed_u32 += ((uint32_t)wbRed << 2);
         wbBlue_u32 += ((uint32_t)wbBlue << 2);
@@ -331,11 +338,9 @@ void runcam_wb(uint8_t wbMode, uint8_t wbRed, uint8_t wbBlue) {
 }
 
 void runcam_hv_flip(uint8_t val) {
-    if (camera_type != CAMERA_TYPE_RUNCAM_MICRO_V2 && camera_type != CAMERA_TYPE_RUNCAM_NANO_90 && camera_type != CAMERA_TYPE_RUNCAM_MICRO_V3)
+    if (!(runcam_model->caps & RUNCAM_CAP_HV_FLIP))
         return;
 
-    camera_setting_reg_set[8] = val;
-
     if (val == 0) // no flip
         RUNCAM_Read_Write(camera_device, 0x000040, 0x0022ffa9);
     else if (val == 1) // hv flip
@@ -351,22 +356,14 @@ void runcam_night_mode(uint8_t val) {
         0: night mode off
         1: night mode on
     */
-    if (camera_type != CAMERA_TYPE_RUNCAM_MICRO_V2 && camera_type != CAMERA_TYPE_RUNCAM_NANO_90 && camera_type != CAMERA_TYPE_RUNCAM_MICRO_V3)
+    if (!(runcam_model->caps & RUNCAM_CAP_NIGHT))
         return;
 
-    camera_setting_reg_set[9] = val;
-
     if (val == 0) { // Max gain off
         RUNCAM_Read_Write(camera_device, 0x000070, 0x10000040);
-        if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3) {
-            RUNCAM_Read_Write(camera_device, 0x000718, 0x30003000);
-            RUNCAM_Read_Write(camera_device, 0x00071c, 0x32003200);
-            RUNCAM_Read_Write(camera_device, 0x000720, 0x34003400);
-        } else {
-            RUNCAM_Read_Write(camera_device, 0x000718, 0x30002900);
-            RUNCAM_Read_Write(camera_device, 0x00071c, 0x32003100);
-            RUNCAM_Read_Write(camera_device, 0x000720, 0x34003300);
-        }
+        RUNCAM_Read_Write(camera_device, 0x000718, runcam_model->night_off[0]);
+        RUNCAM_Read_Write(camera_device, 0x00071c, runcam_model->night_off[1]);
+        RUNCAM_Read_Write(camera_device, 0x000720, runcam_model->night_off[2]);
     } else if (val == 1) { // Max gain on
         RUNCAM_Read_Write(camera_device, 0x000070, 0x10000040);
         RUNCAM_Read_Write(camera_device, 0x000718, 0x28002700);
@@ -391,47 +388,16 @@ uint8_t runcam_video_format(uint8_t val) {
     */
     uint8_t ret = 0;
 
-    camera_setting_reg_set[11] = val;
+    if (!runcam_model->vdo_fmt || val > 3)
+        return ret;
 
-    if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1)
-        ;
-    else if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2) {
-        if (val == 0)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x0008910B);
-        else if (val == 1)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x00089102);
-        else if (val == 2)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x00089110);
-        else if (val == 3) // 1080p30
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x81089106);
-
-        if (val == 3) // 1080p30
-            ret |= RUNCAM_Read_Write(camera_device, 0x000034, 0x00014441);
-        else
-            ret |= RUNCAM_Read_Write(camera_device, 0x000034, 0x00012941);
-    } else if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3) {
-        if (val == 0)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x8208910B);
-        else if (val == 1)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x82089102);
-        else if (val == 2)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x82089110);
-        else if (val == 3)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x81089106);
+    ret |= RUNCAM_Read_Write(camera_device, 0x000008, runcam_model->vdo_fmt[val]);
 
+    if (runcam_model->caps & RUNCAM_CAP_FMT_1080) {
         if (val == 3) // 1080p30
             ret |= RUNCAM_Read_Write(camera_device, 0x000034, 0x00014441);
         else
             ret |= RUNCAM_Read_Write(camera_device, 0x000034, 0x00012941);
-    } else if (camera_type == CAMERA_TYPE_RUNCAM_NANO_90) {
-        if (val == 0)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x8008811d);
-        else if (val == 1)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x83088120);
-        else if (val == 2)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x8108811e);
-        else if (val == 3)
-            ret |= RUNCAM_Read_Write(camera_device, 0x000008, 0x8208811f);
     }
 
     return ret;
@@ -440,8 +406,7 @@ uint8_t runcam_video_format(uint8_t val) {
 void runcam_shutter(uint8_t val) {
     uint32_t dat = 0;
 
-    camera_setting_reg_set[4] = val;
-    if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V1) {
+    if (!runcam_model->shutter_auto) {
         RUNCAM_Write(camera_device, 0x00006c, 0x000004a6);
         WAIT(50);
         RUNCAM_Write(camera_device, 0x000044, 0x80019229);
@@ -449,10 +414,7 @@ void runcam_shutter(uint8_t val) {
         return;
     } else {
         if (val == 0) { // auto
-            if (camera_type == CAMERA_TYPE_RUNCAM_MICRO_V2 || camera_type == CAMERA_TYPE_RUNCAM_MICRO_V3)
-                dat = 0x460;
-            else if (camera_type == CAMERA_TYPE_RUNCAM_NANO_90)
-                dat = 0x447;
+            dat = runcam_model->shutter_auto;
             // DO NOT REMOVE, Otherwise, auto mode may fail to be set.
             RUNCAM_Write(camera_device, 0x00006c, 800);
             WAIT(50);
@@ -477,9 +439,9 @@ void runcam_shutter_fix(uint16_t sec) {
         Setting the shutter for RUNCAM_NANO_90 in the first few seconds of power-on will not take effect, so configure the shutter speed after little seconds.
     */
     if (sec >= 1 && !fixed) {
-        if (camera_type == CAMERA_TYPE_RUNCAM_NANO_90) {
+        if (runcam_model->caps & RUNCAM_CAP_SHUTTER_FIX) {
             if (val == 0) {
-                dat = 0x447;
+                dat = runcam_model->shutter_auto;
             } else {
                 dat = (uint32_t)(val) * 25;
             }
@@ -493,55 +455,92 @@ void runcam_shutter_fix(uint16_t sec) {
     }
 }
 
-uint8_t runcam_setting_update_need(uint8_t *setting_p, uint8_t start, uint8_t stop) {
-    uint8_t i;
-    for (i = start; i <= stop; i++) {
-        if (camera_setting_reg_set[i] != setting_p[i])
-            return 1;
+// Write one register group from camera_setting_reg_set
+static uint8_t runcam_group_write(uint8_t group) {
+    uint8_t *set = camera_setting_reg_set;
+
+    switch (group) {
+    case CAM_SETTING_BRIGHTNESS: // include led_mode
+        runcam_brightness(set[CAM_SETTING_BRIGHTNESS], set[CAM_SETTING_LED_MODE]);
+        break;
+    case CAM_SETTING_SHARPNESS:
+        runcam_sharpness(set[CAM_SETTING_SHARPNESS]);
+        break;
+    case CAM_SETTING_CONTRAST:
+        runcam_contrast(set[CAM_SETTING_CONTRAST]);
+        break;
+    case CAM_SETTING_SATURATION:
+        runcam_saturation(set[CAM_SETTING_SATURATION]);
+        break;
+    case CAM_SETTING_SHUTTER:
+        runcam_shutter(set[CAM_SETTING_SHUTTER]);
+        break;
+    case CAM_SETTING_WBMODE: // include wb red/blue
+        runcam_wb(set[CAM_SETTING_WBMODE], set[CAM_SETTING_WBRED], set[CAM_SETTING_WBBLUE]);
+        break;
+    case CAM_SETTING_HVFLIP:
+        runcam_hv_flip(set[CAM_SETTING_HVFLIP]);
+        break;
+    case CAM_SETTING_NIGHT_MODE:
+        runcam_night_mode(set[CAM_SETTING_NIGHT_MODE]);
+        break;
+    case CAM_SETTING_VDO_FMT:
+        return runcam_video_format(set[CAM_SETTING_VDO_FMT]);
+    default:
+        break;
     }
     return 0;
 }
 
-void runcam_save(void) {
-    RUNCAM_Write(camera_device, 0x000694, 0x00000310);
-    RUNCAM_Write(camera_device, 0x000694, 0x00000311);
-}
+uint8_t runcam_apply_setting(uint16_t id_val) {
+    uint8_t id = id_val >> 8;
 
-void runcam_reset_isp(void) {
-    RUNCAM_Write(camera_device, 0x000694, 0x00000130);
+    if (id >= CAMERA_SETTING_NUM || runcam_setting_group[id] == 0xff)
+        return 0;
+
+    camera_setting_reg_set[id] = id_val & 0xff;
+    return runcam_group_write(runcam_setting_group[id]);
 }
 
-uint8_t runcam_set(uint8_t *setting_profile) {
+// Only the groups with a changed setting are written, once per group
+uint8_t runcam_apply_profile(uint8_t *setting_profile) {
     static uint8_t init_done = 0;
+    uint16_t dirty = 0;
+    uint8_t i;
     uint8_t ret = 0;
-    if (!init_done || runcam_setting_update_need(setting_profile, 0, 0) || runcam_setting_update_need(setting_profile, 10, 10))
-        runcam_brightness(setting_profile[0], setting_profile[10]); // include led_mode
-
-    if (!init_done || runcam_setting_update_need(setting_profile, 1, 1))
-        runcam_sharpness(setting_profile[1]);
-
-    if (!init_done || runcam_setting_update_need(setting_profile, 2, 2))
-        runcam_contrast(setting_profile[2]);
 
-    if (!init_done || runcam_setting_update_need(setting_profile, 3, 3))
-        runcam_saturation(setting_profile[3]);
-
-    if (!init_done || runcam_setting_update_need(setting_profile, 4, 4))
-        runcam_shutter(setting_profile[4]);
+    for (i = 0; i < CAMERA_SETTING_NUM; i++) {
+        if (runcam_setting_group[i] == 0xff)
+            continue;
+        if (!init_done || camera_setting_reg_set[i] != setting_profile[i]) {
+            camera_setting_reg_set[i] = setting_profile[i];
+            dirty |= (uint16_t)1 << runcam_setting_group[i];
+        }
+    }
 
-    if (!init_done || runcam_setting_update_need(setting_profile, 5, 7))
-        runcam_wb(setting_profile[5], setting_profile[6], setting_profile[7]);
+    for (i = 0; i < CAMERA_SETTING_NUM; i++) {
+        if (dirty & ((uint16_t)1 << i))
+            ret |= runcam_group_write(i);
+    }
 
-    if (!init_done || runcam_setting_update_need(setting_profile, 8, 8))
-        runcam_hv_flip(setting_profile[8]);
+    init_done = 1;
+    return ret;
+}
 
-    if (!init_done || runcam_setting_update_need(setting_profile, 9, 9))
-        runcam_night_mode(setting_profile[9]);
+void runcam_save(void) {
+    RUNCAM_Write(camera_device, 0x000694, 0x00000310);
+    RUNCAM_Write(camera_device, 0x000694, 0x00000311);
+}
 
-    if (!init_done || runcam_setting_update_need(setting_profile, 11, 11)) {
-        ret = runcam_video_format(setting_profile[11]);
-    }
-    if (!init_done)
-        init_done = 1;
-    return ret;
+void runcam_reset_isp(void) {
+    RUNCAM_Write(camera_device, 0x000694, 0x00000130);
 }
+
+CODE_SEG const camera_driver_t runcam_driver = {
+    runcam_setting_profile_reset,
+    runcam_setting_profile_check,
+    runcam_apply_setting,
+    runcam_apply_profile,
+    runcam_save,
+    runcam_reset_isp,
+};
@@ -1,12 +1,26 @@
 #ifndef __RUNCAM_H_
 #define __RUNCAM_H_
+#include "camera.h"
 #include "stdint.h"
 
-void runcam_type_detect(void);
-void runcam_setting_profile_reset(uint8_t *setting_profile);
-uint8_t runcam_setting_profile_check(uint8_t *setting_profile);
-uint8_t runcam_set(uint8_t *setting_profile);
-void runcam_reset_isp(void);
-void runcam_save(void);
+#define RUNCAM_CAP_HV_FLIP     0x01 // reg 0x40
+#define RUNCAM_CAP_NIGHT       0x02 // reg 0x70/0x718~0x720
+#define RUNCAM_CAP_FMT_1080    0x04 // reg 0x34 follows 1080p30
+#define RUNCAM_CAP_SHUTTER_FIX 0x08 // shutter is written again after power-on
+
+typedef struct {
+    uint8_t type;   // camera_type_e
+    uint8_t device; // I2C address
+    const uint8_t (*attribute)[4];
+    uint32_t brightness;       // reg 0x50 without led mode bits
+    uint16_t shutter_auto;     // reg 0x6c in auto mode, 0: fixed shutter
+    uint8_t caps;              // RUNCAM_CAP_*
+    const uint32_t *vdo_fmt;   // reg 0x08 per video fmt, 0: fixed
+    const uint32_t *night_off; // reg 0x718~0x720 with night mode off
+} runcam_model_t;
+
+extern const camera_driver_t runcam_driver;
+
+void runcam_type_detect(uint8_t type_last);
 void runcam_shutter_fix(uint16_t sec);
-#endif
\ No newline at end of file
+#endif
@@ -20,7 +20,7 @@ uint8_t ch_bf = 0;
 
 #if defined USE_SMARTAUDIO_SW || defined USE_SMARTAUDIO_HW
 uint8_t SA_is_0 = 1; // detect pre hreder 0x00
-uint8_t SA_config = 0;
+volatile uint8_t SA_config = 0;
 
 uint8_t sa_rbuf[8];
 uint8_t SA_dbm = 14;
@@ -323,29 +323,36 @@ void SA_Update(uint8_t cmd) {
     }
 }
 #if defined USE_SMARTAUDIO_SW
+// Session is opened by suart_idleint(). UART0 stays enabled, Timer0 has the
+// higher interrupt priority instead, so SA never blocks the MSP stream.
 uint8_t SA_task(void) {
-    static uint8_t st = 0, SA = 0xFF;
-
-    if (st == 0) { // monitor SA pin
-        SA = (SA << 1) | SUART_PORT;
-        if (SA == 0xfe) {
-            SA_config = 1;
-            SA_is_0 = 1;
-            IE = 0xC2; // UART1 & Timer0 enabled, UART0 disabled
+    static uint8_t st = 0;
+    static uint16_t sa_tick;
+
+    if (st == 0) {
+        if (SA_config) {
+            sa_tick = timer_ms10x;
             st = 1;
         }
-    } else {
-        if (SA_Process()) {
-            SA_config = 0;
-            IE = 0xD2; // UART1 & Timer0 enabled, UART0 0 enable
-            st = 0;
-            SA = 0xFF;
-        }
+    } else if (st == 1) {
+        if (SA_Process() || ((uint16_t)(timer_ms10x - sa_tick) > SA_SESSION_TIMEOUT))
+            st = 2; // the reply is clocked out from Timer0, main loop goes on
+    }
+
+    if (st == 2 && !suart_tx_en) {
+        SA_config = 0;
+        st = 0;
     }
-    return st;
+    return (st == 1);
 }
 #elif defined USE_SMARTAUDIO_HW
 uint8_t SA_task(void) {
+    if (sa_status == SA_ST_TX) {
+        if (suart_tx_en)
+            return 0; // reply still going out from Timer0
+        sa_status = SA_ST_IDLE;
+        uart_set_baudrate(BAUDRATE);
+    }
     return 1 - SA_Process();
 }
 uint8_t SA_timeout(void) {
@@ -14,6 +14,8 @@
 #define SA_SET_FREQ     0x04
 #define SA_SET_MODE     0x05
 
+#define SA_SESSION_TIMEOUT (TIMER0_1S / 5) // no complete frame, give the pin back
+
 typedef enum {
     SA_HEADER0,
     SA_HEADER1,
@@ -5,7 +5,7 @@
 #include "msp_displayport.h"
 #include "print.h"
 
-uint8_t tr_tx_busy = 0;
+volatile uint8_t tr_tx_busy = 0;
 uint8_t tramp_lock = 0;
 
 #ifdef USE_TRAMP
@@ -13,6 +13,11 @@ static trampReceiveState_e trampReceiveState = S_WAIT_LEN;
 static uint8_t tbuf[16];
 static uint8_t rbuf[16];
 static uint8_t r_ptr;
+static volatile uint8_t tr_tx_idx;
+static volatile uint8_t tr_echo_idx = 16; // next tbuf byte expected back on the half-duplex line
+static uint16_t tr_tx_tick;
+static uint8_t tramp_listen = 0; // boot listen window, see tramp_init()
+static uint16_t tramp_listen_tick;
 
 // Calculate tramp protocol checksum of provided buffer
 static uint8_t tramp_checksum(uint8_t *buf) {
@@ -31,21 +36,43 @@ void tramp_reset_receive(void) {
     r_ptr = 0;
 }
 
+// Queue the reply, tramp_txint() sends the rest from the UART1 ISR
 void trampResponse(void) {
-    uint8_t i;
+    if (tr_tx_busy)
+        return;
 
     tbuf[14] = tramp_checksum(tbuf);
     tbuf[15] = 0x00;
 
+    tr_echo_idx = 0;
+    tr_tx_tick = timer_ms10x;
+    tr_tx_idx = 1;
     tr_tx_busy = 1;
+    RS_Xbusy1 = 1;
+    SBUF1 = tbuf[0];
+}
 
-    for (i = 0; i < 16; i++) {
-        tr_tx(tbuf[i]);
+void tramp_txint(void) // ISR
+{
+    if (tr_tx_idx < 16) {
+        SBUF1 = tbuf[tr_tx_idx++];
+    } else {
+        tr_tx_busy = 0;
+        RS_Xbusy1 = 0;
     }
+}
 
-    WAIT(1);
-    tr_tx_busy = 0;
-    tr_read(); // fix me!
+// UART1 ISR: drop rdata if it is the next byte of our own reply coming back.
+// Checked on arrival, the main loop may block for longer than the timeout.
+uint8_t tramp_is_echo(uint8_t rdata) {
+    if (tr_echo_idx >= 16)
+        return 0;
+    if (rdata == tbuf[tr_echo_idx] && (uint16_t)(timer_ms10x - tr_tx_tick) < TRAMP_ECHO_TIMEOUT) {
+        tr_echo_idx++;
+        return 1;
+    }
+    tr_echo_idx = 16; // not an echo, stop looking for one
+    return 0;
 }
 
 static void set_freq(uint16_t freq) {
@@ -244,18 +271,21 @@ void tramp_receive(void) {
         }
         }
     }
+
+    if (tramp_listen && (tramp_lock || (uint16_t)(timer_ms10x - tramp_listen_tick) > TRAMP_LISTEN_TIME)) {
+        tramp_listen = 0;
+        if (!tramp_lock)
+            RF_POWER = I2C_Read8(ADDR_EEPROM, EEP_ADDR_RF_POWER);
+    }
 }
 
+// Stay at 0mW until the FC talks Tramp or the listen window in
+// tramp_receive() runs out, then fall back to the saved power.
 void tramp_init(void) {
 #ifndef _RF_CALIB
-    uint16_t time_ms = 3000;
     RF_POWER = POWER_MAX + 2;
-    while (time_ms--) {
-        timer_task();
-        tramp_receive();
-    }
-    if (!tramp_lock)
-        RF_POWER = I2C_Read8(ADDR_EEPROM, EEP_ADDR_RF_POWER);
+    tramp_listen = 1;
+    tramp_listen_tick = timer_ms10x;
 #endif
 }
 #endif
\ No newline at end of file
@@ -9,6 +9,9 @@
 #define tr_read(void)  RS_rx1(void)
 #define tr_tx(c)       RS_tx1(c)
 
+#define TRAMP_ECHO_TIMEOUT (TIMER0_1S / 100) // 16 bytes at 115200 take 1.4ms
+#define TRAMP_LISTEN_TIME  (TIMER0_1S / 4)   // boot window for the FC to take over
+
 typedef enum {
     S_WAIT_LEN = 0, // Waiting for a packet len
     S_WAIT_CODE,    // Waiting for a response code
@@ -17,7 +20,9 @@ typedef enum {
 
 void tramp_receive(void);
 void tramp_init(void);
+void tramp_txint(void);
+uint8_t tramp_is_echo(uint8_t rdata);
 #endif
-extern uint8_t tr_tx_busy;
+extern volatile uint8_t tr_tx_busy;
 extern uint8_t tramp_lock;
 #endif
\ No newline at end of file
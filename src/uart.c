@@ -5,6 +5,7 @@
 #include "print.h"
 #include "smartaudio_protocol.h"
 #include <stdint.h>
+#include <string.h>
 
 XDATA_SEG uint8_t RS_buf[BUF_MAX];
 #ifdef EXTEND_BUF
@@ -173,14 +174,29 @@ uint8_t RS_rx1_len(void)
 #ifdef USE_SMARTAUDIO_SW
 XDATA_SEG uint8_t SUART_rbuf[SUART_BUF_MAX];
 XDATA_SEG uint8_t SUART_rin = 0, SUART_rout = 0, SUART_rERR = 0;
+XDATA_SEG uint16_t suart_frame_err = 0; // bytes dropped for a low stop bit
 
+// Timer0 ISR while no SA session is open: a low after 7 high samples opens one
+void suart_idleint() {
+    static uint8_t sa = 0xff;
+
+    sa = (sa << 1) | SUART_PORT;
+    if (sa == 0xfe) {
+        SA_is_0 = 1;
+        SA_config = 1;
+        sa = 0xff;
+    }
+}
+
+// SUART_OVERSAMPLE samples per bit, each bit decided by majority
 void suart_rxint() // ISR
 {
     static uint8_t isSearchingStart = 1;
     static uint8_t si_d = 1;
-    static uint8_t bcnt = 0;
+    static uint8_t bcnt = 0; // 0: start bit, 1~8: data, 9: stop bit
     static uint8_t rxbyte = 0;
     static uint8_t cnt = 0;
+    static uint8_t ones = 0;
     uint8_t si;
 
     si = SUART_PORT;
@@ -193,28 +209,48 @@ void suart_rxint() // ISR
             isSearchingStart = 0;
             bcnt = 0;
             rxbyte = 0;
-            cnt = 0x0;
+            cnt = 1; // this sample is the first of the start bit
+            ones = 0;
         }
         si_d = si;
         return;
-    } else {
-        cnt++;
-        if (cnt >= 2) {
-            cnt = 0;
-            if (bcnt < 8) {
-                rxbyte >>= 1;
-                if (si)
-                    rxbyte |= 0x80;
-                bcnt++;
-            } else {
-                isSearchingStart = 1;
-                si_d = 1;
+    }
 
-                SUART_rbuf[SUART_rin++] = rxbyte;
-                SUART_rin &= (SUART_BUF_MAX - 1);
-            }
-        }
+    ones += si;
+    cnt++;
+
+    // mid-point of the start bit has to be low, otherwise it was a glitch
+    if (bcnt == 0 && cnt == 2 && si) {
+        isSearchingStart = 1;
+        si_d = 1;
+        return;
     }
+
+    if (cnt < SUART_OVERSAMPLE)
+        return;
+
+    si = (ones >= 2);
+    cnt = 0;
+    ones = 0;
+
+    if (bcnt == 9) {
+        isSearchingStart = 1;
+        si_d = 1;
+
+        if (si) {
+            SUART_rbuf[SUART_rin++] = rxbyte;
+            SUART_rin &= (SUART_BUF_MAX - 1);
+        } else if (suart_frame_err != 0xffff)
+            suart_frame_err++;
+        return;
+    }
+
+    if (bcnt) {
+        rxbyte >>= 1;
+        if (si)
+            rxbyte |= 0x80;
+    }
+    bcnt++;
 }
 
 uint8_t SUART_ready() {
@@ -236,7 +272,10 @@ uint8_t SUART_rx() {
 
 ////////////////////////////////////////////////////////////////////////////
 // SUART TX
-uint8_t suart_tx_en = 0;
+// SUART_tx() queues the reply, suart_txint() clocks it out from Timer0
+XDATA_SEG uint8_t suart_tbuf[SUART_TBUF_MAX];
+uint8_t suart_tlen = 0, suart_tidx = 0;
+volatile uint8_t suart_tx_en = 0;
 uint8_t suart_txbcnt = 0;
 uint16_t suart_txdat;
 
@@ -245,32 +284,35 @@ void suart_txint() // ISR
     static uint8_t cnt = 0;
 
     cnt++;
-    if (cnt >= 2) {
+    if (cnt >= SUART_OVERSAMPLE) {
         cnt = 0;
         SUART_PORT = suart_txdat & 1;
         suart_txdat >>= 1;
         suart_txbcnt++;
         if (suart_txbcnt >= 11) {
-            suart_tx_en = 0;
-            SUART_PORT = 1;
+            if (suart_tidx < suart_tlen) {
+                suart_txdat = ((uint16_t)suart_tbuf[suart_tidx++] << 1) | 0xFE00;
+                suart_txbcnt = 0;
+            } else {
+                suart_tx_en = 0;
+                SUART_PORT = 1;
+            }
         }
     }
 }
 
-void SUART_tx_byte(uint8_t dat) {
-    suart_txdat = (dat << 1) | 0xFE00;
+void SUART_tx(uint8_t *tbuf, uint8_t len) {
+    if (len == 0)
+        return;
+    if (len > SUART_TBUF_MAX)
+        len = SUART_TBUF_MAX;
+    memcpy(suart_tbuf, tbuf, len);
+    suart_tlen = len;
+    suart_tidx = 1;
+    suart_txdat = ((uint16_t)suart_tbuf[0] << 1) | 0xFE00;
     suart_txbcnt = 0;
     suart_tx_en = 1;
 }
-
-void SUART_tx(uint8_t *tbuf, uint8_t len) {
-    uint8_t i;
-    for (i = 0; i < len; i++) {
-        SUART_tx_byte(tbuf[i]);
-        while (suart_tx_en)
-            ;
-    }
-}
 #elif defined USE_SMARTAUDIO_HW
 uint8_t SUART_ready() {
     return RS_ready1();
@@ -278,14 +320,37 @@ uint8_t SUART_ready() {
 uint8_t SUART_rx() {
     return RS_rx1();
 }
+
+// SUART_tx() queues the reply, suart_txint() feeds UART1 from Timer0
+XDATA_SEG uint8_t suart_tbuf[SUART_TBUF_MAX];
+uint8_t suart_tlen = 0, suart_tidx = 0;
+volatile uint8_t suart_tx_en = 0;
+
+void suart_txint() // ISR
+{
+    static uint8_t gap = 0;
+
+    if (gap) { // extern 1 stop bits
+        gap--;
+        return;
+    }
+    if (RS_Xbusy1)
+        return;
+    if (suart_tidx < suart_tlen) {
+        SBUF1 = suart_tbuf[suart_tidx++];
+        RS_Xbusy1 = 1;
+        gap = SUART_TX_GAP;
+    } else
+        suart_tx_en = 0;
+}
+
 void SUART_tx(uint8_t *tbuf, uint8_t len) {
-    uint8_t i;
+    if (len > SUART_TBUF_MAX)
+        len = SUART_TBUF_MAX;
+    memcpy(suart_tbuf, tbuf, len);
+    suart_tlen = len;
+    suart_tidx = 0;
     sa_status = SA_ST_TX;
-    for (i = 0; i < len; i++) {
-        RS_tx1(tbuf[i]);
-        WAIT(2); // extern 1 stop bits
-    }
-    sa_status = SA_ST_IDLE;
-    uart_set_baudrate(BAUDRATE);
+    suart_tx_en = 1;
 }
 #endif
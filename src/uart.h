@@ -61,20 +61,29 @@ extern XDATA_SEG volatile uint8_t RS_out1;
 #endif
 
 #ifdef USE_SMARTAUDIO_SW
-#define SUART_BUF_MAX 32 // has to be power of 2
+#define SUART_BUF_MAX    32 // has to be power of 2
+#define SUART_TBUF_MAX   20 // longest SA_Response()
+#define SUART_OVERSAMPLE 3  // Timer0 ticks per bit while SA_config is set
 
-extern uint8_t suart_tx_en;
+extern volatile uint8_t suart_tx_en;
 void suart_txint();
 void suart_rxint();
+void suart_idleint();
 
 uint8_t SUART_ready();
 uint8_t SUART_rx();
 
 void SUART_tx(uint8_t *tbuf, uint8_t len);
 extern uint8_t SA_is_0;
-extern uint8_t SA_config;
+extern volatile uint8_t SA_config;
+extern XDATA_SEG uint16_t suart_frame_err;
 
 #elif defined USE_SMARTAUDIO_HW
+#define SUART_TBUF_MAX 20               // longest SA_Response()
+#define SUART_TX_GAP   (TIMER0_1S / 500) // 2ms from one byte to the next
+
+extern volatile uint8_t suart_tx_en;
+void suart_txint();
 uint8_t SUART_ready();
 uint8_t SUART_rx();
 void SUART_tx(uint8_t *tbuf, uint8_t len);